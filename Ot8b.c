@@ -1,1209 +1,2224 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include <memory.h>
-#include <time.h>
-#include <assert.h>
-
-#define Board_Size 8
-#define TRUE 1
-#define FALSE 0
-#define INF 1000000000
-
-void Delay(unsigned int mseconds);
-// int Read_File( FILE *p, char *c );//open a file and get the next move, for play by file
-char Load_File(void); // load a file and start a game
-
-void Init();
-int Play_a_Move(int x, int y);
-void Show_Board_and_Set_Legal_Moves(void);
-int Put_a_Stone(int x, int y);
-
-int In_Board(int x, int y);
-int Check_Cross(int x, int y, int update);
-int Check_Straight_Army(int x, int y, int d, int update);
-
-int Find_Legal_Moves(int color);
-int Check_EndGame(void);
-int Compute_Grades(int flag);
-
-void Computer_Think(int *x, int *y);
-int Search(int myturn, int mylevel);
-int search_next(int x, int y, int myturn, int mylevel, int alpha, int beta);
-
-int Search_Counter;
-int Computer_Take;
-int Winner;
-int Now_Board[Board_Size][Board_Size];
-int Legal_Moves[Board_Size][Board_Size];
-int HandNumber;
-int sequence[100];
-
-int Black_Count, White_Count;
-int Turn = 0;           // 0 is black or 1 is white
-int Stones[2] = {1, 2}; // 1: black, 2: white
-int DirX[8] = {0, 1, 1, 1, 0, -1, -1, -1};
-int DirY[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
-
-int LastX, LastY;
-int Think_Time = 0, Total_Time = 0;
-
-int search_deep = 8; // slightly deeper default search for stronger play
-
-int alpha_beta_option = TRUE;
-int resultX, resultY;
-
-// Improved positional weights for stronger play
-int board_weight[8][8] =
-    // a,  b,   c,   d,   e,   f,   g,   h
-    {
-        {120, -25, 20, 5, 5, 20, -25, 120},     // 1
-        {-25, -45, -10, -5, -5, -10, -45, -25}, // 2
-        {20, -10, 15, 3, 3, 15, -10, 20},       // 3
-        {5, -5, 3, 1, 1, 3, -5, 5},             // 4
-        {5, -5, 3, 1, 1, 3, -5, 5},             // 5
-        {20, -10, 15, 3, 3, 15, -10, 20},       // 6
-        {-25, -45, -10, -5, -5, -10, -45, -25}, // 7
-        {120, -25, 20, 5, 5, 20, -25, 120}      // 8
-};
-
-// Transposition table & Zobrist hashing for caching positions
-typedef struct
-{
-    unsigned long long key;
-    int depth;
-    int value;
-    int flag; // 0: exact, 1: lower bound, 2: upper bound
-    int bestX;
-    int bestY;
-} TTEntry;
-
-// Larger TT for stronger play
-#define TT_SIZE (1 << 21)
-#define TT_FLAG_EXACT 0
-#define TT_FLAG_LOWER 1
-#define TT_FLAG_UPPER 2
-
-unsigned long long zobrist_table[Board_Size][Board_Size][3];
-unsigned long long zobrist_turn[2];
-TTEntry transTable[TT_SIZE];
-
-typedef struct
-{
-    int x;
-    int y;
-    int score;
-} Move;
-
-void init_zobrist(void);
-unsigned long long rand64(void);
-unsigned long long compute_hash(int myturn);
-
-int count_empty(void);
-int is_corner(int x, int y);
-int is_x_square(int x, int y);
-int is_c_square(int x, int y);
-int move_heuristic(int x, int y);
-
-int negamax(int depth, int alpha, int beta, int myturn);
-int negamax_root(int depth, int myturn, int *outX, int *outY);
-
-typedef struct location
-{
-    int i;
-    int j;
-    int g;
-} Location;
-
-//---------------------------------------------------------------------------
-
-// Zobrist hashing initialization
-void init_zobrist(void)
-{
-    int i, j, k;
-    for (i = 0; i < Board_Size; ++i)
-        for (j = 0; j < Board_Size; ++j)
-            for (k = 0; k < 3; ++k)
-                zobrist_table[i][j][k] = rand64();
-
-    zobrist_turn[0] = rand64();
-    zobrist_turn[1] = rand64();
-
-    memset(transTable, 0, sizeof(transTable));
-}
-
-unsigned long long rand64(void)
-{
-    unsigned long long r = (unsigned long long)rand();
-    r ^= ((unsigned long long)rand() << 15);
-    r ^= ((unsigned long long)rand() << 30);
-    r ^= ((unsigned long long)rand() << 45);
-    r ^= ((unsigned long long)rand() << 60);
-    return r;
-}
-
-unsigned long long compute_hash(int myturn)
-{
-    unsigned long long h = zobrist_turn[myturn];
-    int i, j;
-    for (i = 0; i < Board_Size; ++i)
-        for (j = 0; j < Board_Size; ++j)
-            if (Now_Board[i][j] != 0)
-                h ^= zobrist_table[i][j][Now_Board[i][j]];
-    return h;
-}
-
-int count_empty(void)
-{
-    int i, j;
-    int empty = 0;
-    for (i = 0; i < Board_Size; ++i)
-        for (j = 0; j < Board_Size; ++j)
-            if (Now_Board[i][j] == 0)
-                empty++;
-    return empty;
-}
-
-int is_corner(int x, int y)
-{
-    return ((x == 0 || x == Board_Size - 1) && (y == 0 || y == Board_Size - 1));
-}
-
-int is_x_square(int x, int y)
-{
-    return ((x == 1 && y == 1) ||
-            (x == Board_Size - 2 && y == 1) ||
-            (x == 1 && y == Board_Size - 2) ||
-            (x == Board_Size - 2 && y == Board_Size - 2));
-}
-
-int is_c_square(int x, int y)
-{
-    if ((x == 0 && y == 1) || (x == 1 && y == 0) ||
-        (x == Board_Size - 2 && y == 0) || (x == Board_Size - 1 && y == 1) ||
-        (x == 0 && y == Board_Size - 2) || (x == 1 && y == Board_Size - 1) ||
-        (x == Board_Size - 2 && y == Board_Size - 1) || (x == Board_Size - 1 && y == Board_Size - 2))
-        return 1;
-    return 0;
-}
-
-int move_heuristic(int x, int y)
-{
-    int score = board_weight[x][y];
-    int empty = count_empty();
-    int discs = Board_Size * Board_Size - empty;
-
-    // Corners are extremely valuable
-    if (is_corner(x, y))
-        score += 10000;
-
-    // X-squares are dangerous if corner empty
-    if (is_x_square(x, y))
-    {
-        if (x == 1 && y == 1 && Now_Board[0][0] == 0)
-            score -= (discs < 48) ? 8000 : 2000;
-        if (x == Board_Size - 2 && y == 1 && Now_Board[Board_Size - 1][0] == 0)
-            score -= (discs < 48) ? 8000 : 2000;
-        if (x == 1 && y == Board_Size - 2 && Now_Board[0][Board_Size - 1] == 0)
-            score -= (discs < 48) ? 8000 : 2000;
-        if (x == Board_Size - 2 && y == Board_Size - 2 && Now_Board[Board_Size - 1][Board_Size - 1] == 0)
-            score -= (discs < 48) ? 8000 : 2000;
-    }
-
-    // C-squares also dangerous early if corner empty
-    if (is_c_square(x, y))
-    {
-        int penalty = (discs < 40) ? 4000 : 1000;
-
-        if (x == 0 && y == 1 && Now_Board[0][0] == 0)
-            score -= penalty;
-        if (x == 1 && y == 0 && Now_Board[0][0] == 0)
-            score -= penalty;
-
-        if (x == Board_Size - 2 && y == 0 && Now_Board[Board_Size - 1][0] == 0)
-            score -= penalty;
-        if (x == Board_Size - 1 && y == 1 && Now_Board[Board_Size - 1][0] == 0)
-            score -= penalty;
-
-        if (x == 0 && y == Board_Size - 2 && Now_Board[0][Board_Size - 1] == 0)
-            score -= penalty;
-        if (x == 1 && y == Board_Size - 1 && Now_Board[0][Board_Size - 1] == 0)
-            score -= penalty;
-
-        if (x == Board_Size - 2 && y == Board_Size - 1 && Now_Board[Board_Size - 1][Board_Size - 1] == 0)
-            score -= penalty;
-        if (x == Board_Size - 1 && y == Board_Size - 2 && Now_Board[Board_Size - 1][Board_Size - 1] == 0)
-            score -= penalty;
-    }
-
-    return score;
-}
-
-//---------------------------------------------------------------------------
-
-int main(int argc, char *argv[])
-{
-    char compcolor = 'W', c[10];
-    int column_input, row_input;
-    int rx, ry, m = 0, n;
-    FILE *fp;
-
-    Init();
-
-    if (argc == 3)
-    {
-        compcolor = *argv[1];
-        if (atoi(argv[2]) > 0)
-            search_deep = atoi(argv[2]);
-        printf("%c, %d\n", compcolor, search_deep);
-    }
-    else if (argc == 2)
-    {
-        compcolor = *argv[1];
-    }
-    else
-    {
-        printf("Computer take?(B/W/All/File play as first/file play as Second/Load and play): ");
-        scanf("%c", &compcolor);
-    }
-
-    Show_Board_and_Set_Legal_Moves();
-
-    if (compcolor == 'L' || compcolor == 'l')
-        compcolor = Load_File();
-
-    if (compcolor == 'B' || compcolor == 'b')
-    {
-        Computer_Think(&rx, &ry);
-        printf("Computer played %c%d\n", rx + 97, ry + 1);
-        Play_a_Move(rx, ry);
-
-        Show_Board_and_Set_Legal_Moves();
-    }
-
-    if (compcolor == 'A' || compcolor == 'a')
-        while (m++ < 64)
-        {
-            Computer_Think(&rx, &ry);
-            if (!Play_a_Move(rx, ry))
-            {
-                printf("Wrong Computer moves %c%d\n", rx + 97, ry + 1);
-                scanf("%d", &n);
-                break;
-            }
-            if (rx == -1)
-                printf("Computer Pass\n");
-            else
-                printf("Computer played %c%d\n", rx + 97, ry + 1);
-
-            if (Check_EndGame())
-                return 0;
-            Show_Board_and_Set_Legal_Moves();
-        }
-
-    if (compcolor == 'F')
-    {
-        printf("First/Black start!\n");
-        Computer_Think(&rx, &ry);
-        Play_a_Move(rx, ry);
-    }
-
-    while (m++ < 64)
-    {
-        while (1)
-        {
-            if (compcolor == 'F' || compcolor == 'S')
-            {
-                fp = fopen("of.txt", "r");
-                fscanf(fp, "%d", &n);
-                char tc[10];
-                if (compcolor == 'F')
-                {
-                    if (n % 2 == 0)
-                    {
-                        while ((fscanf(fp, "%s", tc)) != EOF)
-                        {
-                            c[0] = tc[0];
-                            c[1] = tc[1];
-                        }
-                        fclose(fp);
-
-                        if (c[0] == 'w')
-                            return 0;
-                        if (c[0] != 'p' && Now_Board[c[0] - 97][c[1] - 49] != 0)
-                        {
-                            printf("%s is wrong F\n", c);
-                            continue;
-                        }
-                    }
-                    else
-                    {
-                        fclose(fp);
-                        Delay(100);
-                        continue;
-                    }
-                }
-                else
-                {
-                    if (n % 2 == 1)
-                    {
-                        while ((fscanf(fp, "%s", tc)) != EOF)
-                        {
-                            c[0] = tc[0];
-                            c[1] = tc[1];
-                        }
-                        fclose(fp);
-                        if (c[0] == 'w')
-                            return 0;
-                        if (c[0] != 'p' && Now_Board[c[0] - 97][c[1] - 49] != 0)
-                        {
-                            printf("%s is wrong S\n", c);
-                            continue;
-                        }
-                    }
-                    else
-                    {
-                        fclose(fp);
-                        Delay(100);
-                        continue;
-                    }
-                }
-            }
-
-            if (compcolor == 'B')
-            {
-                printf("input White move:(a-h 1-8), or PASS\n");
-                scanf("%s", c);
-            }
-            else if (compcolor == 'W')
-            {
-                printf("input Black move:(a-h 1-8), or PASS\n");
-                scanf("%s", c);
-            }
-
-            if (c[0] == 'P' || c[0] == 'p')
-                row_input = column_input = -1;
-            else if (c[0] == 'M' || c[0] == 'm')
-            {
-                Computer_Think(&rx, &ry);
-                if (!Play_a_Move(rx, ry))
-                {
-                    printf("Wrong Computer moves %c%d\n", rx + 97, ry + 1);
-                    scanf("%d", &n);
-                    break;
-                }
-                if (rx == -1)
-                    printf("Computer Pass");
-                else
-                    printf("Computer played %c%d\n", rx + 97, ry + 1);
-                if (Check_EndGame())
-                    break;
-                Show_Board_and_Set_Legal_Moves();
-            }
-            else
-            {
-                row_input = c[0] - 97;
-                column_input = c[1] - 49;
-            }
-
-            if (!Play_a_Move(row_input, column_input))
-            {
-                printf("#%d, %c%d is a Wrong move\n", HandNumber, c[0], column_input + 1);
-                return 0;
-            }
-
-            else
-                break;
-        }
-        if (Check_EndGame())
-            return 0;
-        Show_Board_and_Set_Legal_Moves();
-
-        Computer_Think(&rx, &ry);
-        printf("Computer played %c%d\n", rx + 97, ry + 1);
-        Play_a_Move(rx, ry);
-        if (Check_EndGame())
-            return 0;
-        Show_Board_and_Set_Legal_Moves();
-    }
-
-    printf("Game is over!!");
-    printf("\n%d", argc);
-    if (argc <= 1)
-        scanf("%d", &n);
-
-    return 0;
-}
-//---------------------------------------------------------------------------
-void Delay(unsigned int mseconds)
-{
-    clock_t goal = mseconds + clock();
-    while (goal > clock())
-        ;
-}
-//---------------------------------------------------------------------------
-
-char Load_File(void)
-{
-    FILE *fp;
-    char tc[10];
-    int row_input, column_input, n;
-
-    fp = fopen("of.txt", "r");
-    assert(fp != NULL);
-
-    fscanf(fp, "%d", &n);
-
-    while ((fscanf(fp, "%s", tc)) != EOF)
-    {
-        row_input = tc[0] - 97;
-        column_input = tc[1] - 49;
-        if (!Play_a_Move(row_input, column_input))
-            printf("%c%d is a Wrong move\n", tc[0], column_input + 1);
-
-        Show_Board_and_Set_Legal_Moves();
-    }
-    fclose(fp);
-    return (n % 2 == 1) ? 'B' : 'W';
-}
-//---------------------------------------------------------------------------
-
-void Init()
-{
-    Total_Time = clock();
-
-    Computer_Take = 0;
-    memset(Now_Board, 0, sizeof(int) * Board_Size * Board_Size);
-
-    srand((unsigned int)time(NULL));
-    init_zobrist();
-    Now_Board[3][3] = Now_Board[4][4] = 2; // white, dark
-    Now_Board[3][4] = Now_Board[4][3] = 1; // black, light
-
-    HandNumber = 0;
-    memset(sequence, -1, sizeof(int) * 100);
-    Turn = 0;
-
-    LastX = LastY = -1;
-    Black_Count = White_Count = 0;
-
-    Search_Counter = 0;
-    Winner = 0;
-}
-//---------------------------------------------------------------------------
-
-int Play_a_Move(int x, int y)
-{
-    FILE *fp;
-
-    if (x == -1 && y == -1)
-    {
-        fp = fopen("of.txt", "r+");
-
-        fprintf(fp, "%2d\n", HandNumber + 1);
-        fclose(fp);
-
-        fp = fopen("of.txt", "a");
-        fprintf(fp, "p9\n");
-        fclose(fp);
-
-        sequence[HandNumber] = -1;
-        HandNumber++;
-        Turn = 1 - Turn;
-        return 1;
-    }
-
-    if (!In_Board(x, y))
-        return 0;
-    Find_Legal_Moves(Stones[Turn]);
-    if (Legal_Moves[x][y] == FALSE)
-        return 0;
-
-    if (Put_a_Stone(x, y))
-    {
-        Check_Cross(x, y, 1);
-
-        Compute_Grades(TRUE);
-        return 1;
-    }
-    else
-        return 0;
-}
-//---------------------------------------------------------------------------
-
-int Put_a_Stone(int x, int y)
-{
-    FILE *fp;
-
-    if (Now_Board[x][y] == 0)
-    {
-        sequence[HandNumber] = Turn;
-        if (HandNumber == 0)
-            fp = fopen("of.txt", "w");
-        else
-            fp = fopen("of.txt", "r+");
-        fprintf(fp, "%2d\n", HandNumber + 1);
-        HandNumber++;
-        fclose(fp);
-
-        Now_Board[x][y] = Stones[Turn];
-        fp = fopen("of.txt", "a");
-        fprintf(fp, "%c%d\n", x + 97, y + 1);
-        ;
-        fclose(fp);
-
-        LastX = x;
-        LastY = y;
-
-        Turn = 1 - Turn;
-
-        return TRUE;
-    }
-    return FALSE;
-}
-//---------------------------------------------------------------------------
-
-void Show_Board_and_Set_Legal_Moves(void)
-{
-    int i, j;
-
-    Find_Legal_Moves(Stones[Turn]);
-
-    printf("a b c d e f g h\n");
-    for (i = 0; i < Board_Size; i++)
-    {
-        for (j = 0; j < Board_Size; j++)
-        {
-            if (Now_Board[j][i] > 0)
-            {
-                if (Now_Board[j][i] == 2)
-                    printf("O "); // white
-                else
-                    printf("X "); // black
-            }
-
-            if (Now_Board[j][i] == 0)
-            {
-                if (Legal_Moves[j][i] == 1)
-                    printf("? ");
-                else
-                    printf(". ");
-            }
-        }
-        printf(" %d\n", i + 1);
-    }
-    printf("\n");
-}
-//---------------------------------------------------------------------------
-
-int Find_Legal_Moves(int color)
-{
-    int i, j;
-    int me = color;
-    int legal_count = 0;
-
-    for (i = 0; i < Board_Size; i++)
-        for (j = 0; j < Board_Size; j++)
-            Legal_Moves[i][j] = 0;
-
-    for (i = 0; i < Board_Size; i++)
-        for (j = 0; j < Board_Size; j++)
-            if (Now_Board[i][j] == 0)
-            {
-                Now_Board[i][j] = me;
-                if (Check_Cross(i, j, FALSE) == TRUE)
-                {
-                    Legal_Moves[i][j] = TRUE;
-                    legal_count++;
-                }
-                Now_Board[i][j] = 0;
-            }
-
-    return legal_count;
-}
-//---------------------------------------------------------------------------
-
-int Check_Cross(int x, int y, int update)
-{
-    int k;
-    int dx, dy;
-
-    if (!In_Board(x, y) || Now_Board[x][y] == 0)
-        return FALSE;
-
-    {
-        int army = 3 - Now_Board[x][y];
-        int army_count = 0;
-
-        for (k = 0; k < 8; k++)
-        {
-            dx = x + DirX[k];
-            dy = y + DirY[k];
-            if (In_Board(dx, dy) && Now_Board[dx][dy] == army)
-            {
-                army_count += Check_Straight_Army(x, y, k, update);
-            }
-        }
-
-        if (army_count > 0)
-            return TRUE;
-        else
-            return FALSE;
-    }
-}
-//---------------------------------------------------------------------------
-
-int Check_Straight_Army(int x, int y, int d, int update)
-{
-    int me = Now_Board[x][y];
-    int army = 3 - me;
-    int army_count = 0;
-    int found_flag = FALSE;
-    int flag[Board_Size][Board_Size] = {{0}};
-
-    int i, j;
-    int tx, ty;
-
-    tx = x;
-    ty = y;
-
-    for (i = 0; i < Board_Size; i++)
-    {
-        tx += DirX[d];
-        ty += DirY[d];
-
-        if (In_Board(tx, ty))
-        {
-            if (Now_Board[tx][ty] == army)
-            {
-                army_count++;
-                flag[tx][ty] = TRUE;
-            }
-            else if (Now_Board[tx][ty] == me)
-            {
-                found_flag = TRUE;
-                break;
-            }
-            else
-                break;
-        }
-        else
-            break;
-    }
-
-    if ((found_flag == TRUE) && (army_count > 0) && update)
-    {
-        for (i = 0; i < Board_Size; i++)
-            for (j = 0; j < Board_Size; j++)
-                if (flag[i][j] == TRUE)
-                {
-                    if (Now_Board[i][j] != 0)
-                        Now_Board[i][j] = 3 - Now_Board[i][j];
-                }
-    }
-    if ((found_flag == TRUE) && (army_count > 0))
-        return army_count;
-    else
-        return 0;
-}
-//---------------------------------------------------------------------------
-
-int In_Board(int x, int y)
-{
-    if (x >= 0 && x < Board_Size && y >= 0 && y < Board_Size)
-        return TRUE;
-    else
-        return FALSE;
-}
-//---------------------------------------------------------------------------
-
-int Compute_Grades(int flag)
-{
-    int i, j;
-    int B = 0, W = 0;
-    int BW = 0, WW = 0;
-    int frontierB = 0, frontierW = 0;
-
-    // Disc counts and positional weights
-    for (i = 0; i < Board_Size; ++i)
-    {
-        for (j = 0; j < Board_Size; ++j)
-        {
-            if (Now_Board[i][j] == 1)
-            {
-                B++;
-                BW += board_weight[i][j];
-            }
-            else if (Now_Board[i][j] == 2)
-            {
-                W++;
-                WW += board_weight[i][j];
-            }
-        }
-    }
-
-    // Frontier discs (stones adjacent to at least one empty square)
-    for (i = 0; i < Board_Size; ++i)
-    {
-        for (j = 0; j < Board_Size; ++j)
-        {
-            if (Now_Board[i][j] == 0)
-                continue;
-
-            int k;
-            int isFrontier = 0;
-            for (k = 0; k < 8; ++k)
-            {
-                int nx = i + DirX[k];
-                int ny = j + DirY[k];
-                if (In_Board(nx, ny) && Now_Board[nx][ny] == 0)
-                {
-                    isFrontier = 1;
-                    break;
-                }
-            }
-
-            if (isFrontier)
-            {
-                if (Now_Board[i][j] == 1)
-                    frontierB++;
-                else if (Now_Board[i][j] == 2)
-                    frontierW++;
-            }
-        }
-    }
-
-    // Mobility
-    int mobilityBlack = Find_Legal_Moves(1);
-    int mobilityWhite = Find_Legal_Moves(2);
-
-    int totalDiscs = B + W;
-    int stage = 0;
-    if (totalDiscs > 0)
-        stage = (totalDiscs * 100) / (Board_Size * Board_Size); // 0..100
-
-    // Normalized differences
-    int discDiffPerc = 0;
-    int posDiffPerc = 0;
-    int mobDiffPerc = 0;
-    int frontierDiffPerc = 0;
-
-    if (B + W != 0)
-        discDiffPerc = 100 * (B - W) / (B + W);
-
-    if (BW + WW != 0)
-        posDiffPerc = 100 * (BW - WW) / (BW + WW);
-
-    if (mobilityBlack + mobilityWhite != 0)
-        mobDiffPerc = 100 * (mobilityBlack - mobilityWhite) / (mobilityBlack + mobilityWhite);
-
-    if (frontierB + frontierW != 0)
-        frontierDiffPerc = 100 * (frontierW - frontierB) / (frontierB + frontierW); // prefer fewer frontier
-
-    // Game phase dependent weights
-    int wDisc = 10 + stage;     // more important late
-    int wPos = 100 - stage / 2; // slightly less important late
-    int wMob = 100 - stage;     // opening/midgame
-    int wFront = 100 - stage;   // opening/midgame
-
-    int score = 0;
-    score += wPos * posDiffPerc;
-    score += wMob * mobDiffPerc;
-    score += wFront * frontierDiffPerc;
-    score += wDisc * discDiffPerc;
-
-    score /= 10; // keep scale reasonable
-
-    if (flag)
-    {
-        Black_Count = B;
-        White_Count = W;
-        printf("#%d Grade: Black %d, White %d\n", HandNumber, B, W);
-    }
-
-    // Positive score means advantage for Black, negative for White.
-    return score;
-}
-//---------------------------------------------------------------------------
-
-int Check_EndGame(void)
-{
-    int i, j;
-    FILE *fp;
-
-    Black_Count = White_Count = 0;
-    for (i = 0; i < Board_Size; i++)
-        for (j = 0; j < Board_Size; j++)
-            if (Now_Board[i][j] == 1)
-                Black_Count++;
-            else if (Now_Board[i][j] == 2)
-                White_Count++;
-
-    if (Black_Count + White_Count == Board_Size * Board_Size)
-    {
-        fp = fopen("of.txt", "a");
-        Total_Time = clock() - Total_Time;
-
-        if (HandNumber % 2 == 1)
-        {
-            fprintf(fp, "Total used time= %d min. %d sec.\n", Total_Time / 60000, (Total_Time % 60000) / 1000);
-            fprintf(fp, "Black used time= %d min. %d sec.\n", Think_Time / 60000, (Think_Time % 60000) / 1000);
-        }
-        else
-        {
-            fprintf(fp, "Total used time= %d min. %d sec.\n", Total_Time / 60000, (Total_Time % 60000) / 1000);
-            fprintf(fp, "White used time= %d min. %d sec.\n", Think_Time / 60000, (Think_Time % 60000) / 1000);
-        }
-
-        if (Black_Count > White_Count)
-        {
-            printf("Black(F) Win!\n");
-            fprintf(fp, "wB%d\n", Black_Count - White_Count);
-            if (Winner == 0)
-                Winner = 1;
-        }
-        else if (Black_Count < White_Count)
-        {
-            printf("White(S) Win!\n");
-            fprintf(fp, "wW%d\n", White_Count - Black_Count);
-            if (Winner == 0)
-                Winner = 2;
-        }
-        else
-        {
-            printf("Draw\n");
-            fprintf(fp, "wZ%d\n", White_Count - Black_Count);
-            Winner = 0;
-        }
-        fclose(fp);
-
-        Show_Board_and_Set_Legal_Moves();
-        printf("Game is over");
-        return TRUE;
-    }
-
-    return FALSE;
-}
-//---------------------------------------------------------------------------
-
-int negamax(int depth, int alpha, int beta, int myturn)
-{
-    int moveCount;
-    int opponentMoves;
-    int bestVal = -INF;
-    int originalAlpha = alpha;
-
-    unsigned long long key = compute_hash(myturn);
-    int index = (int)(key & (TT_SIZE - 1));
-    TTEntry *entry = &transTable[index];
-
-    Search_Counter++;
-
-    // TT lookup
-    if (entry->key == key && entry->depth >= depth)
-    {
-        if (entry->flag == TT_FLAG_EXACT)
-            return entry->value;
-        else if (entry->flag == TT_FLAG_LOWER && entry->value > alpha)
-            alpha = entry->value;
-        else if (entry->flag == TT_FLAG_UPPER && entry->value < beta)
-            beta = entry->value;
-
-        if (alpha >= beta)
-            return entry->value;
-    }
-
-    moveCount = Find_Legal_Moves(Stones[myturn]);
-    if (moveCount == 0)
-    {
-        opponentMoves = Find_Legal_Moves(Stones[1 - myturn]);
-        if (depth == 0 || opponentMoves == 0)
-        {
-            int eval = (myturn == 0 ? 1 : -1) * Compute_Grades(FALSE);
-            entry->key = key;
-            entry->depth = depth;
-            entry->value = eval;
-            entry->flag = TT_FLAG_EXACT;
-            return eval;
-        }
-        // pass move
-        {
-            int val = -negamax(depth - 1, -beta, -alpha, 1 - myturn);
-            entry->key = key;
-            entry->depth = depth;
-            entry->value = val;
-            if (val <= originalAlpha)
-                entry->flag = TT_FLAG_UPPER;
-            else if (val >= beta)
-                entry->flag = TT_FLAG_LOWER;
-            else
-                entry->flag = TT_FLAG_EXACT;
-            return val;
-        }
-    }
-
-    if (depth == 0)
-    {
-        int eval = (myturn == 0 ? 1 : -1) * Compute_Grades(FALSE);
-        entry->key = key;
-        entry->depth = depth;
-        entry->value = eval;
-        entry->flag = TT_FLAG_EXACT;
-        return eval;
-    }
-
-    // Generate & order moves
-    {
-        Move moves[Board_Size * Board_Size];
-        int m = 0;
-        int i, j;
-        for (i = 0; i < Board_Size; ++i)
-            for (j = 0; j < Board_Size; ++j)
-                if (Legal_Moves[i][j] == TRUE)
-                {
-                    moves[m].x = i;
-                    moves[m].y = j;
-                    moves[m].score = move_heuristic(i, j);
-                    m++;
-                }
-
-        // TT best move ordering bonus if available
-        if (entry->key == key && entry->bestX >= 0 && entry->bestY >= 0)
-        {
-            for (int t = 0; t < m; ++t)
-                if (moves[t].x == entry->bestX && moves[t].y == entry->bestY)
-                    moves[t].score += 1000000;
-        }
-
-        // sort by heuristic descending (insertion sort)
-        for (int a = 1; a < m; ++a)
-        {
-            Move keyMove = moves[a];
-            int b = a - 1;
-            while (b >= 0 && moves[b].score < keyMove.score)
-            {
-                moves[b + 1] = moves[b];
-                b--;
-            }
-            moves[b + 1] = keyMove;
-        }
-
-        {
-            int B[Board_Size][Board_Size];
-            int idxMove;
-            int bestX = -1, bestY = -1;
-
-            for (idxMove = 0; idxMove < m; ++idxMove)
-            {
-                int x = moves[idxMove].x;
-                int y = moves[idxMove].y;
-                int val;
-
-                memcpy(B, Now_Board, sizeof(int) * Board_Size * Board_Size);
-                Now_Board[x][y] = Stones[myturn];
-                Check_Cross(x, y, TRUE);
-
-                val = -negamax(depth - 1, -beta, -alpha, 1 - myturn);
-
-                memcpy(Now_Board, B, sizeof(int) * Board_Size * Board_Size);
-
-                if (val > bestVal)
-                {
-                    bestVal = val;
-                    bestX = x;
-                    bestY = y;
-                }
-                if (val > alpha)
-                    alpha = val;
-                if (alpha_beta_option && alpha >= beta)
-                    break;
-            }
-
-            entry->key = key;
-            entry->depth = depth;
-            entry->value = bestVal;
-            entry->bestX = bestX;
-            entry->bestY = bestY;
-
-            if (bestVal <= originalAlpha)
-                entry->flag = TT_FLAG_UPPER;
-            else if (bestVal >= beta)
-                entry->flag = TT_FLAG_LOWER;
-            else
-                entry->flag = TT_FLAG_EXACT;
-        }
-    }
-
-    return bestVal;
-}
-
-int negamax_root(int depth, int myturn, int *outX, int *outY)
-{
-    int moveCount = Find_Legal_Moves(Stones[myturn]);
-    if (moveCount <= 0)
-    {
-        *outX = *outY = -1;
-        return -INF;
-    }
-
-    Move moves[Board_Size * Board_Size];
-    int m = 0;
-    int i, j;
-
-    for (i = 0; i < Board_Size; ++i)
-        for (j = 0; j < Board_Size; ++j)
-            if (Legal_Moves[i][j] == TRUE)
-            {
-                moves[m].x = i;
-                moves[m].y = j;
-                moves[m].score = move_heuristic(i, j);
-                m++;
-            }
-
-    // Root: use TT best move for ordering if available
-    {
-        unsigned long long key = compute_hash(myturn);
-        int index = (int)(key & (TT_SIZE - 1));
-        TTEntry *entry = &transTable[index];
-        if (entry->key == key && entry->bestX >= 0 && entry->bestY >= 0)
-        {
-            for (int t = 0; t < m; ++t)
-                if (moves[t].x == entry->bestX && moves[t].y == entry->bestY)
-                    moves[t].score += 1000000;
-        }
-    }
-
-    // sort moves by heuristic descending (insertion sort)
-    for (int a = 1; a < m; ++a)
-    {
-        Move keyMove = moves[a];
-        int b = a - 1;
-        while (b >= 0 && moves[b].score < keyMove.score)
-        {
-            moves[b + 1] = moves[b];
-            b--;
-        }
-        moves[b + 1] = keyMove;
-    }
-
-    {
-        int bestVal = -INF;
-        int alpha = -INF;
-        int beta = INF;
-        int B[Board_Size][Board_Size];
-        int idxMove;
-
-        *outX = *outY = -1;
-
-        for (idxMove = 0; idxMove < m; ++idxMove)
-        {
-            int x = moves[idxMove].x;
-            int y = moves[idxMove].y;
-            int val;
-
-            memcpy(B, Now_Board, sizeof(int) * Board_Size * Board_Size);
-            Now_Board[x][y] = Stones[myturn];
-            Check_Cross(x, y, TRUE);
-
-            val = -negamax(depth - 1, -beta, -alpha, 1 - myturn);
-
-            memcpy(Now_Board, B, sizeof(int) * Board_Size * Board_Size);
-
-            if (val > bestVal)
-            {
-                bestVal = val;
-                *outX = x;
-                *outY = y;
-            }
-            if (val > alpha)
-                alpha = val;
-        }
-
-        return bestVal;
-    }
-}
-
-int Search(int myturn, int mylevel)
-{
-    int legal;
-    int empty;
-    int maxDepth;
-    int d;
-
-    (void)mylevel; // unused
-
-    legal = Find_Legal_Moves(Stones[myturn]);
-    if (legal <= 0)
-        return FALSE;
-
-    empty = count_empty();
-    maxDepth = search_deep;
-
-    // Extend deeper in late game
-    if (empty <= 14 && empty < maxDepth)
-        maxDepth = empty;
-
-    resultX = resultY = -1;
-
-    // Iterative deepening for better move ordering and TT usage
-    for (d = 1; d <= maxDepth; ++d)
-    {
-        int x = -1, y = -1;
-        negamax_root(d, myturn, &x, &y);
-        if (x != -1 && y != -1)
-        {
-            resultX = x;
-            resultY = y;
-        }
-    }
-
-    return (resultX != -1 && resultY != -1);
-}
-
-int search_next(int x, int y, int myturn, int mylevel, int alpha, int beta)
-{
-    // Legacy interface not used by new search; keep stub for compatibility.
-    (void)x;
-    (void)y;
-    (void)myturn;
-    (void)mylevel;
-    (void)alpha;
-    (void)beta;
-    return Compute_Grades(FALSE);
-}
-//---------------------------------------------------------------------------
-
-void Computer_Think(int *x, int *y)
-{
-    time_t clockBegin, clockEnd;
-    int flag;
-
-    clockBegin = clock();
-
-    resultX = resultY = -1;
-    Search_Counter = 0;
-
-    flag = Search(Turn, 0);
-
-    clockEnd = clock();
-    {
-        int tinterval = (int)(clockEnd - clockBegin);
-        Think_Time += tinterval;
-        if (tinterval < 200)
-            Delay((unsigned int)(200 - tinterval));
-    }
-    printf("used thinking time= %d min. %d.%d sec.\n",
-           Think_Time / 60000,
-           (Think_Time % 60000) / 1000,
-           (Think_Time % 60000) % 1000);
-
-    if (flag)
-    {
-        *x = resultX;
-        *y = resultY;
-    }
-    else
-    {
-        *x = *y = -1;
-    }
-}
-//---------------------------------------------------------------------------
\ No newline at end of file
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <memory.h>
+#include <time.h>
+#include <assert.h>
+#include <pthread.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HAVE_AVX2_KERNELS 1
+#endif
+
+#define Board_Size 8
+#define TRUE 1
+#define FALSE 0
+#define INF 1000000000
+
+// Search state that every Lazy SMP thread keeps its own copy of
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+void Delay(unsigned int mseconds);
+// int Read_File( FILE *p, char *c );//open a file and get the next move, for play by file
+char Load_File(void); // load a file and start a game
+
+void Init();
+int Play_a_Move(int x, int y);
+void Show_Board_and_Set_Legal_Moves(void);
+int Put_a_Stone(int x, int y);
+
+int In_Board(int x, int y);
+
+int Find_Legal_Moves(int color);
+int Check_EndGame(void);
+int Compute_Grades(int flag);
+
+void Computer_Think(int *x, int *y);
+int Search(int myturn, int mylevel);
+int search_next(int x, int y, int myturn, int mylevel, int alpha, int beta);
+
+THREAD_LOCAL int Search_Counter;
+int Computer_Take;
+int Winner;
+int Now_Board[Board_Size][Board_Size];
+int Legal_Moves[Board_Size][Board_Size];
+int HandNumber;
+int sequence[100];
+
+int Black_Count, White_Count;
+int Turn = 0;           // 0 is black or 1 is white
+int Stones[2] = {1, 2}; // 1: black, 2: white
+
+// Bitboard board representation: bit (y * 8 + x) is square (x, y), a1 = bit 0.
+// Now_Bits[0] holds black discs, Now_Bits[1] white discs; Now_Board mirrors it for display and file play.
+typedef unsigned long long Bitboard;
+
+#define SQ(x, y) ((y) * Board_Size + (x))
+#define SQ_BIT(x, y) (1ULL << SQ(x, y))
+#define NOT_A_FILE 0xFEFEFEFEFEFEFEFEULL
+#define NOT_H_FILE 0x7F7F7F7F7F7F7F7FULL
+
+THREAD_LOCAL Bitboard Now_Bits[2];
+
+// Shift and wrap mask per direction: N, NE, E, SE, S, SW, W, NW
+int Dir_Shift[8] = {-8, -7, 1, 9, 8, 7, -1, -9};
+Bitboard Dir_Mask[8] = {~0ULL, NOT_A_FILE, NOT_A_FILE, NOT_A_FILE, ~0ULL, NOT_H_FILE, NOT_H_FILE, NOT_H_FILE};
+
+int bit_count(Bitboard b);
+int first_bit(Bitboard b);
+Bitboard shift_dir(Bitboard b, int d);
+Bitboard get_moves_scalar(Bitboard P, Bitboard O);
+Bitboard get_flips_scalar(int sq, Bitboard P, Bitboard O);
+#ifdef HAVE_AVX2_KERNELS
+Bitboard get_moves_avx2(Bitboard P, Bitboard O);
+Bitboard get_flips_avx2(int sq, Bitboard P, Bitboard O);
+#endif
+void init_kernels(void);
+
+// Move generation / flip kernels, chosen at startup by init_kernels()
+Bitboard (*get_moves)(Bitboard P, Bitboard O) = get_moves_scalar;
+Bitboard (*get_flips)(int sq, Bitboard P, Bitboard O) = get_flips_scalar;
+Bitboard neighbours(Bitboard b);
+int weight_sum(Bitboard b);
+void Bits_To_Board(void);
+
+int LastX, LastY;
+int Think_Time = 0, Total_Time = 0;
+
+int search_deep = 8; // slightly deeper default search for stronger play
+
+int alpha_beta_option = TRUE;
+int resultX, resultY;
+
+// Improved positional weights for stronger play
+int board_weight[8][8] =
+    // a,  b,   c,   d,   e,   f,   g,   h
+    {
+        {120, -25, 20, 5, 5, 20, -25, 120},     // 1
+        {-25, -45, -10, -5, -5, -10, -45, -25}, // 2
+        {20, -10, 15, 3, 3, 15, -10, 20},       // 3
+        {5, -5, 3, 1, 1, 3, -5, 5},             // 4
+        {5, -5, 3, 1, 1, 3, -5, 5},             // 5
+        {20, -10, 15, 3, 3, 15, -10, 20},       // 6
+        {-25, -45, -10, -5, -5, -10, -45, -25}, // 7
+        {120, -25, 20, 5, 5, 20, -25, 120}      // 8
+};
+
+// Transposition table & Zobrist hashing for caching positions
+typedef struct
+{
+    unsigned long long key;
+    int depth;
+    int value;
+    int flag; // 0: exact, 1: lower bound, 2: upper bound
+    int bestX;
+    int bestY;
+} TTEntry;
+
+// Stored form of a TTEntry.  All fields but the key are packed into data and the
+// key is stored XORed with data, so an entry torn by two threads writing at once
+// fails the key check instead of returning mixed fields.
+typedef struct
+{
+    unsigned long long check; // key ^ data
+    unsigned long long data;  // value:32 | depth:8 | flag:2 | best square + 1:7
+} TTSlot;
+
+// Larger TT for stronger play
+#define TT_SIZE (1 << 21)
+#define TT_FLAG_EXACT 0
+#define TT_FLAG_LOWER 1
+#define TT_FLAG_UPPER 2
+
+unsigned long long zobrist_table[Board_Size][Board_Size][3];
+unsigned long long zobrist_turn[2];
+TTSlot transTable[TT_SIZE];
+THREAD_LOCAL unsigned long long TT_Probes, TT_Hits; // negamax probe statistics
+
+int tt_probe(unsigned long long key, TTEntry *entry);
+void tt_store(unsigned long long key, int depth, int value, int flag, int bestX, int bestY);
+
+// Lazy SMP: helper threads run their own iterative deepening over the shared TT
+#define MAX_THREADS 64
+
+typedef struct
+{
+    pthread_t thread;
+    int id;
+    int myturn;
+    int maxDepth;
+    Bitboard bits[2];
+    int nodes;
+} SearchHelper;
+
+int Search_Threads = 1;
+volatile int Stop_Search;             // set when helpers must unwind
+THREAD_LOCAL int Root_Offset;         // helper root move rotation
+SearchHelper Helpers[MAX_THREADS];
+
+void *search_helper(void *arg);
+
+// Exact endgame solver: plays for the final disc difference only.
+// Empty squares are kept in a linked list, and Parity has one bit per 4x4 quadrant
+// holding an odd number of empties.
+#define ENDGAME_SHALLOW 6     // at or below: parity ordering only, no TT
+#define ENDGAME_TT_EMPTIES 9  // at or above: probe the TT
+
+typedef struct SquareList
+{
+    int sq;
+    int quadrant; // quadrant bit of sq
+    struct SquareList *prev;
+    struct SquareList *next;
+} SquareList;
+
+typedef struct
+{
+    int sq;
+    int score;
+    Bitboard flips;
+} EndMove;
+
+int endgame_empties = 20; // solve exactly from this many empties
+
+THREAD_LOCAL SquareList Empty_List[Board_Size * Board_Size + 1]; // last one is the head
+THREAD_LOCAL SquareList *Empty_Node[Board_Size * Board_Size];
+THREAD_LOCAL int Parity;
+Bitboard Neighbour_Mask[Board_Size * Board_Size];
+
+void init_empty_list(Bitboard empty);
+unsigned long long endgame_hash(Bitboard P, Bitboard O);
+int solve_final(Bitboard P, Bitboard O, int empties);
+int solve_1(Bitboard P, Bitboard O, int sq);
+int solve_2(Bitboard P, Bitboard O, int alpha, int beta, int s1, int s2, int passed);
+int solve_3(Bitboard P, Bitboard O, int alpha, int beta, int s1, int s2, int s3, int passed);
+int solve_4(Bitboard P, Bitboard O, int alpha, int beta, int s1, int s2, int s3, int s4, int passed);
+int solve_shallow(Bitboard P, Bitboard O, int alpha, int beta, int empties, int passed);
+int solve_deep(Bitboard P, Bitboard O, int alpha, int beta, int empties);
+int order_endgame_moves(Bitboard P, Bitboard O, Bitboard legal, int hashSq, EndMove *moves);
+int solve_root(int myturn, int *outX, int *outY);
+
+typedef struct
+{
+    int x;
+    int y;
+    int score;
+} Move;
+
+void init_zobrist(void);
+unsigned long long rand64(void);
+unsigned long long compute_hash(int myturn);
+
+// Make / unmake with incremental Zobrist key; each ply pushes its flips on Undo_Stack
+#define MAX_PLY 128
+
+typedef struct
+{
+    Bitboard flips;         // discs turned over, 0 for a pass
+    int sq;                 // square played, -1 for a pass
+    unsigned long long key; // Now_Key before the move
+} Undo;
+
+THREAD_LOCAL unsigned long long Now_Key;
+THREAD_LOCAL Undo Undo_Stack[MAX_PLY];
+THREAD_LOCAL int Undo_Ply;
+
+void make_move(int sq, Bitboard flips, int myturn);
+void make_pass(void);
+void unmake_move(int myturn);
+
+int count_empty(void);
+int is_corner(int x, int y);
+int is_x_square(int x, int y);
+int is_c_square(int x, int y);
+int move_heuristic(int x, int y);
+
+int negamax(int depth, int alpha, int beta, int myturn);
+int negamax_root(int depth, int myturn, int *outX, int *outY);
+
+// Command line tools
+int Set_Position(const char *pos);
+unsigned long long perft(int depth, int myturn);
+void Run_Perft(int depth, int divide);
+void Run_Bench(int depth, int json);
+
+// Benchmark suite: fixed midgame positions searched at fixed depths.
+// Bump BENCH_VERSION whenever a position or depth changes so old results are not compared.
+#define BENCH_VERSION 1
+
+typedef struct
+{
+    const char *pos; // Set_Position format
+    int depth;
+} BenchPosition;
+
+BenchPosition Bench_Positions[] = {
+    {"-----O-------O--X-XOXOO--XXOX-----XOO-----XOOO-----X------XO----X", 9},  // 42 empties
+    {"XO-------XOO----X-XXXX--XXOOOO--XOOOO----OOO--------------------X", 9},  // 40 empties
+    {"------X---XXXXOX----O-O---XXOOOO---XXOO----XX-O---OXO------X----X", 9},  // 38 empties
+    {"--XO------XXOO----XOOOX---XOOXX---XOOX--XXXOOO------O--------O--X", 9},  // 36 empties
+    {"-----X------X-----OXXO----XXXXO--XXXXOOO-XOXOOOO--O--X-O--O--X--X", 9},  // 34 empties
+    {"--XXXXX----OXX--O-O-XX-X-OOOOOX-XOOOXO----OOOOOO----X-----------X", 9},  // 32 empties
+    {"XXXXXXXXXXXXOOOOXXXOO---X-OOO----OOOOO----OOOO------------------X", 9},  // 30 empties
+    {"OOOOO----OOOOOX--XOXOOXX--OOXOX--XOXOO----OOXOX---O--X------X---X", 10}, // 28 empties
+    {"--O-OX----O-OX--OOOOOX-O--XOOXO-OOOOOOX-XOOOOO-X--X-O-----X-XXX-X", 10}, // 26 empties
+    {"--OX-X----OXXX----OOXXXO--XOXOOO--XOXXOO--OOXOXO---OOO-O--XOOO-OX", 10}, // 24 empties
+    {"----------------OX-X-OOOOOXXXOXXOXOOOXX-OXOOOOX-OOXOOOX-OOOOOOO-O", 10}, // 22 empties
+    {"--OOOOO----OX----XXXOXX-OOXOOX-XO-OXOOO-OXOOXXOO--XOOX----OOOOOOX", 10}, // 20 empties
+};
+
+typedef struct location
+{
+    int i;
+    int j;
+    int g;
+} Location;
+
+//---------------------------------------------------------------------------
+
+// Zobrist hashing initialization
+void init_zobrist(void)
+{
+    int i, j, k;
+    for (i = 0; i < Board_Size; ++i)
+        for (j = 0; j < Board_Size; ++j)
+            for (k = 0; k < 3; ++k)
+                zobrist_table[i][j][k] = rand64();
+
+    zobrist_turn[0] = rand64();
+    zobrist_turn[1] = rand64();
+
+    memset(transTable, 0, sizeof(transTable));
+}
+
+int tt_probe(unsigned long long key, TTEntry *entry)
+{
+    TTSlot *slot = &transTable[key & (TT_SIZE - 1)];
+    unsigned long long data = slot->data;
+    int best;
+
+    if ((slot->check ^ data) != key)
+        return FALSE;
+
+    entry->key = key;
+    entry->value = (int)(unsigned int)(data & 0xFFFFFFFFULL);
+    entry->depth = (int)((data >> 32) & 0xFF);
+    entry->flag = (int)((data >> 40) & 3);
+    best = (int)((data >> 42) & 0x7F) - 1;
+    entry->bestX = (best >= 0) ? (best & 7) : -1;
+    entry->bestY = (best >= 0) ? (best >> 3) : -1;
+    return TRUE;
+}
+
+void tt_store(unsigned long long key, int depth, int value, int flag, int bestX, int bestY)
+{
+    TTSlot *slot = &transTable[key & (TT_SIZE - 1)];
+    unsigned long long best = (bestX >= 0) ? (unsigned long long)(SQ(bestX, bestY) + 1) : 0;
+    unsigned long long data = (unsigned long long)(unsigned int)value |
+                              ((unsigned long long)(depth & 0xFF) << 32) |
+                              ((unsigned long long)flag << 40) |
+                              (best << 42);
+
+    slot->check = key ^ data;
+    slot->data = data;
+}
+
+unsigned long long rand64(void)
+{
+    unsigned long long r = (unsigned long long)rand();
+    r ^= ((unsigned long long)rand() << 15);
+    r ^= ((unsigned long long)rand() << 30);
+    r ^= ((unsigned long long)rand() << 45);
+    r ^= ((unsigned long long)rand() << 60);
+    return r;
+}
+
+unsigned long long compute_hash(int myturn)
+{
+    unsigned long long h = zobrist_turn[myturn];
+    int c;
+    for (c = 0; c < 2; ++c)
+    {
+        Bitboard b = Now_Bits[c];
+        while (b)
+        {
+            int sq = first_bit(b);
+            b &= b - 1;
+            h ^= zobrist_table[sq & 7][sq >> 3][Stones[c]];
+        }
+    }
+    return h;
+}
+
+//---------------------------------------------------------------------------
+// Bitboard core
+
+int bit_count(Bitboard b)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(b);
+#else
+    int n = 0;
+    while (b)
+    {
+        b &= b - 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+int first_bit(Bitboard b)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(b);
+#else
+    int n = 0;
+    while (!(b & 1))
+    {
+        b >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+Bitboard shift_dir(Bitboard b, int d)
+{
+    if (Dir_Shift[d] > 0)
+        return (b << Dir_Shift[d]) & Dir_Mask[d];
+    return (b >> -Dir_Shift[d]) & Dir_Mask[d];
+}
+
+// All squares where the player P can play against the opponent O.
+// Opponent discs on the a/h files can never be bracketed horizontally, so masking
+// them out of O also stops the shifts from wrapping between rows.
+Bitboard get_moves_scalar(Bitboard P, Bitboard O)
+{
+    Bitboard mO = O & 0x7E7E7E7E7E7E7E7EULL;
+    Bitboard moves = 0;
+    Bitboard t;
+
+#define GEN_MOVES_LEFT(s, m)                      \
+    t = m & (P << s);                             \
+    t |= m & (t << s);                            \
+    t |= m & (t << s);                            \
+    t |= m & (t << s);                            \
+    t |= m & (t << s);                            \
+    t |= m & (t << s);                            \
+    moves |= t << s;
+#define GEN_MOVES_RIGHT(s, m)                     \
+    t = m & (P >> s);                             \
+    t |= m & (t >> s);                            \
+    t |= m & (t >> s);                            \
+    t |= m & (t >> s);                            \
+    t |= m & (t >> s);                            \
+    t |= m & (t >> s);                            \
+    moves |= t >> s;
+
+    GEN_MOVES_LEFT(1, mO)
+    GEN_MOVES_RIGHT(1, mO)
+    GEN_MOVES_LEFT(8, O)
+    GEN_MOVES_RIGHT(8, O)
+    GEN_MOVES_LEFT(7, mO)
+    GEN_MOVES_RIGHT(7, mO)
+    GEN_MOVES_LEFT(9, mO)
+    GEN_MOVES_RIGHT(9, mO)
+
+#undef GEN_MOVES_LEFT
+#undef GEN_MOVES_RIGHT
+
+    return moves & ~(P | O);
+}
+
+// Opponent discs flipped when P plays on square sq (0 if the move is illegal)
+Bitboard get_flips_scalar(int sq, Bitboard P, Bitboard O)
+{
+    Bitboard flips = 0;
+    Bitboard start = 1ULL << sq;
+    int d;
+
+    for (d = 0; d < 8; ++d)
+    {
+        Bitboard f = 0;
+        Bitboard b = shift_dir(start, d);
+        while (b & O)
+        {
+            f |= b;
+            b = shift_dir(b, d);
+        }
+        if (b & P)
+            flips |= f;
+    }
+    return flips;
+}
+
+#ifdef HAVE_AVX2_KERNELS
+// AVX2 kernels: the four shift amounts (1, 8, 9, 7) sit in the four 64-bit lanes,
+// left shifts and right shifts cover all 8 directions at once.
+
+__attribute__((target("avx2"))) static Bitboard or_lanes(__m256i v)
+{
+    __m128i x = _mm_or_si128(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    x = _mm_or_si128(x, _mm_unpackhi_epi64(x, x));
+    return (Bitboard)_mm_cvtsi128_si64(x);
+}
+
+__attribute__((target("avx2"))) Bitboard get_moves_avx2(Bitboard P, Bitboard O)
+{
+    const __m256i shift = _mm256_set_epi64x(7, 9, 8, 1);
+    const __m256i mask = _mm256_set_epi64x(0x7E7E7E7E7E7E7E7EULL, 0x7E7E7E7E7E7E7E7EULL,
+                                           0xFFFFFFFFFFFFFFFFULL, 0x7E7E7E7E7E7E7E7EULL);
+    __m256i PP = _mm256_set1_epi64x((long long)P);
+    __m256i mO = _mm256_and_si256(_mm256_set1_epi64x((long long)O), mask);
+    __m256i fl = _mm256_and_si256(mO, _mm256_sllv_epi64(PP, shift));
+    __m256i fr = _mm256_and_si256(mO, _mm256_srlv_epi64(PP, shift));
+    __m256i moves;
+    int i;
+
+    for (i = 0; i < 5; ++i)
+    {
+        fl = _mm256_or_si256(fl, _mm256_and_si256(mO, _mm256_sllv_epi64(fl, shift)));
+        fr = _mm256_or_si256(fr, _mm256_and_si256(mO, _mm256_srlv_epi64(fr, shift)));
+    }
+    moves = _mm256_or_si256(_mm256_sllv_epi64(fl, shift), _mm256_srlv_epi64(fr, shift));
+
+    return or_lanes(moves) & ~(P | O);
+}
+
+__attribute__((target("avx2"))) Bitboard get_flips_avx2(int sq, Bitboard P, Bitboard O)
+{
+    const __m256i shift = _mm256_set_epi64x(7, 9, 8, 1);
+    const __m256i mask = _mm256_set_epi64x(0x7E7E7E7E7E7E7E7EULL, 0x7E7E7E7E7E7E7E7EULL,
+                                           0xFFFFFFFFFFFFFFFFULL, 0x7E7E7E7E7E7E7E7EULL);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i XX = _mm256_set1_epi64x((long long)(1ULL << sq));
+    __m256i PP = _mm256_set1_epi64x((long long)P);
+    __m256i mO = _mm256_and_si256(_mm256_set1_epi64x((long long)O), mask);
+    __m256i fl = _mm256_and_si256(mO, _mm256_sllv_epi64(XX, shift));
+    __m256i fr = _mm256_and_si256(mO, _mm256_srlv_epi64(XX, shift));
+    __m256i capl, capr;
+    int i;
+
+    // run of opponent discs from sq in each direction
+    for (i = 0; i < 5; ++i)
+    {
+        fl = _mm256_or_si256(fl, _mm256_and_si256(mO, _mm256_sllv_epi64(fl, shift)));
+        fr = _mm256_or_si256(fr, _mm256_and_si256(mO, _mm256_srlv_epi64(fr, shift)));
+    }
+
+    // keep a run only if the square just past it holds one of our discs
+    capl = _mm256_and_si256(_mm256_sllv_epi64(_mm256_or_si256(fl, XX), shift), PP);
+    capr = _mm256_and_si256(_mm256_srlv_epi64(_mm256_or_si256(fr, XX), shift), PP);
+    fl = _mm256_andnot_si256(_mm256_cmpeq_epi64(capl, zero), fl);
+    fr = _mm256_andnot_si256(_mm256_cmpeq_epi64(capr, zero), fr);
+
+    return or_lanes(_mm256_or_si256(fl, fr));
+}
+#endif
+
+//---------------------------------------------------------------------------
+
+// Play sq for myturn, flipping flips, and update Now_Key incrementally
+void make_move(int sq, Bitboard flips, int myturn)
+{
+    Undo *u = &Undo_Stack[Undo_Ply++];
+    unsigned long long key = Now_Key;
+    Bitboard f = flips;
+
+    u->flips = flips;
+    u->sq = sq;
+    u->key = key;
+
+    Now_Bits[myturn] |= flips | (1ULL << sq);
+    Now_Bits[1 - myturn] ^= flips;
+
+    key ^= zobrist_table[sq & 7][sq >> 3][Stones[myturn]];
+    while (f)
+    {
+        int s = first_bit(f);
+        f &= f - 1;
+        key ^= zobrist_table[s & 7][s >> 3][1] ^ zobrist_table[s & 7][s >> 3][2];
+    }
+    Now_Key = key ^ zobrist_turn[0] ^ zobrist_turn[1];
+}
+
+void make_pass(void)
+{
+    Undo *u = &Undo_Stack[Undo_Ply++];
+
+    u->flips = 0;
+    u->sq = -1;
+    u->key = Now_Key;
+    Now_Key ^= zobrist_turn[0] ^ zobrist_turn[1];
+}
+
+// Take back the last make_move/make_pass; myturn is the side that made it
+void unmake_move(int myturn)
+{
+    Undo *u = &Undo_Stack[--Undo_Ply];
+
+    if (u->sq >= 0)
+    {
+        Now_Bits[myturn] ^= u->flips | (1ULL << u->sq);
+        Now_Bits[1 - myturn] ^= u->flips;
+    }
+    Now_Key = u->key;
+}
+//---------------------------------------------------------------------------
+
+// Pick the fastest kernels the CPU supports
+void init_kernels(void)
+{
+    get_moves = get_moves_scalar;
+    get_flips = get_flips_scalar;
+#ifdef HAVE_AVX2_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        get_moves = get_moves_avx2;
+        get_flips = get_flips_avx2;
+    }
+#endif
+}
+
+// Squares adjacent (8-way) to any square of b
+Bitboard neighbours(Bitboard b)
+{
+    Bitboard n = 0;
+    int d;
+    for (d = 0; d < 8; ++d)
+        n |= shift_dir(b, d);
+    return n;
+}
+
+int weight_sum(Bitboard b)
+{
+    int sum = 0;
+    while (b)
+    {
+        int sq = first_bit(b);
+        b &= b - 1;
+        sum += board_weight[sq & 7][sq >> 3];
+    }
+    return sum;
+}
+
+// Refresh the Now_Board mirror from the bitboards
+void Bits_To_Board(void)
+{
+    int i, j;
+    for (i = 0; i < Board_Size; ++i)
+        for (j = 0; j < Board_Size; ++j)
+        {
+            if (Now_Bits[0] & SQ_BIT(i, j))
+                Now_Board[i][j] = Stones[0];
+            else if (Now_Bits[1] & SQ_BIT(i, j))
+                Now_Board[i][j] = Stones[1];
+            else
+                Now_Board[i][j] = 0;
+        }
+}
+//---------------------------------------------------------------------------
+
+int count_empty(void)
+{
+    return Board_Size * Board_Size - bit_count(Now_Bits[0] | Now_Bits[1]);
+}
+
+int is_corner(int x, int y)
+{
+    return ((x == 0 || x == Board_Size - 1) && (y == 0 || y == Board_Size - 1));
+}
+
+int is_x_square(int x, int y)
+{
+    return ((x == 1 && y == 1) ||
+            (x == Board_Size - 2 && y == 1) ||
+            (x == 1 && y == Board_Size - 2) ||
+            (x == Board_Size - 2 && y == Board_Size - 2));
+}
+
+int is_c_square(int x, int y)
+{
+    if ((x == 0 && y == 1) || (x == 1 && y == 0) ||
+        (x == Board_Size - 2 && y == 0) || (x == Board_Size - 1 && y == 1) ||
+        (x == 0 && y == Board_Size - 2) || (x == 1 && y == Board_Size - 1) ||
+        (x == Board_Size - 2 && y == Board_Size - 1) || (x == Board_Size - 1 && y == Board_Size - 2))
+        return 1;
+    return 0;
+}
+
+int move_heuristic(int x, int y)
+{
+    int score = board_weight[x][y];
+    Bitboard occupied = Now_Bits[0] | Now_Bits[1];
+    int discs = bit_count(occupied);
+
+    // Corners are extremely valuable
+    if (is_corner(x, y))
+        score += 10000;
+
+    // X-squares are dangerous if corner empty
+    if (is_x_square(x, y))
+    {
+        if (x == 1 && y == 1 && !(occupied & SQ_BIT(0, 0)))
+            score -= (discs < 48) ? 8000 : 2000;
+        if (x == Board_Size - 2 && y == 1 && !(occupied & SQ_BIT(Board_Size - 1, 0)))
+            score -= (discs < 48) ? 8000 : 2000;
+        if (x == 1 && y == Board_Size - 2 && !(occupied & SQ_BIT(0, Board_Size - 1)))
+            score -= (discs < 48) ? 8000 : 2000;
+        if (x == Board_Size - 2 && y == Board_Size - 2 && !(occupied & SQ_BIT(Board_Size - 1, Board_Size - 1)))
+            score -= (discs < 48) ? 8000 : 2000;
+    }
+
+    // C-squares also dangerous early if corner empty
+    if (is_c_square(x, y))
+    {
+        int penalty = (discs < 40) ? 4000 : 1000;
+
+        if (x == 0 && y == 1 && !(occupied & SQ_BIT(0, 0)))
+            score -= penalty;
+        if (x == 1 && y == 0 && !(occupied & SQ_BIT(0, 0)))
+            score -= penalty;
+
+        if (x == Board_Size - 2 && y == 0 && !(occupied & SQ_BIT(Board_Size - 1, 0)))
+            score -= penalty;
+        if (x == Board_Size - 1 && y == 1 && !(occupied & SQ_BIT(Board_Size - 1, 0)))
+            score -= penalty;
+
+        if (x == 0 && y == Board_Size - 2 && !(occupied & SQ_BIT(0, Board_Size - 1)))
+            score -= penalty;
+        if (x == 1 && y == Board_Size - 1 && !(occupied & SQ_BIT(0, Board_Size - 1)))
+            score -= penalty;
+
+        if (x == Board_Size - 2 && y == Board_Size - 1 && !(occupied & SQ_BIT(Board_Size - 1, Board_Size - 1)))
+            score -= penalty;
+        if (x == Board_Size - 1 && y == Board_Size - 2 && !(occupied & SQ_BIT(Board_Size - 1, Board_Size - 1)))
+            score -= penalty;
+    }
+
+    return score;
+}
+
+//---------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    char compcolor = 'W', c[10];
+    int column_input, row_input;
+    int rx, ry, m = 0, n;
+    FILE *fp;
+
+    Init();
+
+    // Ot8b bench [depth] [csv|json]
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0)
+    {
+        int depth = 0, json = FALSE;
+        int a;
+        for (a = 2; a < argc; ++a)
+        {
+            if (strcmp(argv[a], "json") == 0)
+                json = TRUE;
+            else if (strcmp(argv[a], "csv") != 0)
+                depth = atoi(argv[a]);
+        }
+        Run_Bench(depth, json);
+        return 0;
+    }
+
+    // Ot8b perft <depth> [divide] [position]
+    if (argc >= 3 && strcmp(argv[1], "perft") == 0)
+    {
+        int divide = FALSE;
+        int a;
+        for (a = 3; a < argc; ++a)
+        {
+            if (strcmp(argv[a], "divide") == 0)
+                divide = TRUE;
+            else if (!Set_Position(argv[a]))
+            {
+                printf("bad position %s\n", argv[a]);
+                return 1;
+            }
+        }
+        Run_Perft(atoi(argv[2]), divide);
+        return 0;
+    }
+
+    if (argc >= 3)
+    {
+        compcolor = *argv[1];
+        if (atoi(argv[2]) > 0)
+            search_deep = atoi(argv[2]);
+        if (argc >= 4 && atoi(argv[3]) > 0)
+            Search_Threads = atoi(argv[3]) < MAX_THREADS ? atoi(argv[3]) : MAX_THREADS;
+        printf("%c, %d, %d threads\n", compcolor, search_deep, Search_Threads);
+    }
+    else if (argc == 2)
+    {
+        compcolor = *argv[1];
+    }
+    else
+    {
+        printf("Computer take?(B/W/All/File play as first/file play as Second/Load and play): ");
+        scanf("%c", &compcolor);
+    }
+
+    Show_Board_and_Set_Legal_Moves();
+
+    if (compcolor == 'L' || compcolor == 'l')
+        compcolor = Load_File();
+
+    if (compcolor == 'B' || compcolor == 'b')
+    {
+        Computer_Think(&rx, &ry);
+        printf("Computer played %c%d\n", rx + 97, ry + 1);
+        Play_a_Move(rx, ry);
+
+        Show_Board_and_Set_Legal_Moves();
+    }
+
+    if (compcolor == 'A' || compcolor == 'a')
+        while (m++ < 64)
+        {
+            Computer_Think(&rx, &ry);
+            if (!Play_a_Move(rx, ry))
+            {
+                printf("Wrong Computer moves %c%d\n", rx + 97, ry + 1);
+                scanf("%d", &n);
+                break;
+            }
+            if (rx == -1)
+                printf("Computer Pass\n");
+            else
+                printf("Computer played %c%d\n", rx + 97, ry + 1);
+
+            if (Check_EndGame())
+                return 0;
+            Show_Board_and_Set_Legal_Moves();
+        }
+
+    if (compcolor == 'F')
+    {
+        printf("First/Black start!\n");
+        Computer_Think(&rx, &ry);
+        Play_a_Move(rx, ry);
+    }
+
+    while (m++ < 64)
+    {
+        while (1)
+        {
+            if (compcolor == 'F' || compcolor == 'S')
+            {
+                fp = fopen("of.txt", "r");
+                fscanf(fp, "%d", &n);
+                char tc[10];
+                if (compcolor == 'F')
+                {
+                    if (n % 2 == 0)
+                    {
+                        while ((fscanf(fp, "%s", tc)) != EOF)
+                        {
+                            c[0] = tc[0];
+                            c[1] = tc[1];
+                        }
+                        fclose(fp);
+
+                        if (c[0] == 'w')
+                            return 0;
+                        if (c[0] != 'p' && Now_Board[c[0] - 97][c[1] - 49] != 0)
+                        {
+                            printf("%s is wrong F\n", c);
+                            continue;
+                        }
+                    }
+                    else
+                    {
+                        fclose(fp);
+                        Delay(100);
+                        continue;
+                    }
+                }
+                else
+                {
+                    if (n % 2 == 1)
+                    {
+                        while ((fscanf(fp, "%s", tc)) != EOF)
+                        {
+                            c[0] = tc[0];
+                            c[1] = tc[1];
+                        }
+                        fclose(fp);
+                        if (c[0] == 'w')
+                            return 0;
+                        if (c[0] != 'p' && Now_Board[c[0] - 97][c[1] - 49] != 0)
+                        {
+                            printf("%s is wrong S\n", c);
+                            continue;
+                        }
+                    }
+                    else
+                    {
+                        fclose(fp);
+                        Delay(100);
+                        continue;
+                    }
+                }
+            }
+
+            if (compcolor == 'B')
+            {
+                printf("input White move:(a-h 1-8), or PASS\n");
+                scanf("%s", c);
+            }
+            else if (compcolor == 'W')
+            {
+                printf("input Black move:(a-h 1-8), or PASS\n");
+                scanf("%s", c);
+            }
+
+            if (c[0] == 'P' || c[0] == 'p')
+                row_input = column_input = -1;
+            else if (c[0] == 'M' || c[0] == 'm')
+            {
+                Computer_Think(&rx, &ry);
+                if (!Play_a_Move(rx, ry))
+                {
+                    printf("Wrong Computer moves %c%d\n", rx + 97, ry + 1);
+                    scanf("%d", &n);
+                    break;
+                }
+                if (rx == -1)
+                    printf("Computer Pass");
+                else
+                    printf("Computer played %c%d\n", rx + 97, ry + 1);
+                if (Check_EndGame())
+                    break;
+                Show_Board_and_Set_Legal_Moves();
+            }
+            else
+            {
+                row_input = c[0] - 97;
+                column_input = c[1] - 49;
+            }
+
+            if (!Play_a_Move(row_input, column_input))
+            {
+                printf("#%d, %c%d is a Wrong move\n", HandNumber, c[0], column_input + 1);
+                return 0;
+            }
+
+            else
+                break;
+        }
+        if (Check_EndGame())
+            return 0;
+        Show_Board_and_Set_Legal_Moves();
+
+        Computer_Think(&rx, &ry);
+        printf("Computer played %c%d\n", rx + 97, ry + 1);
+        Play_a_Move(rx, ry);
+        if (Check_EndGame())
+            return 0;
+        Show_Board_and_Set_Legal_Moves();
+    }
+
+    printf("Game is over!!");
+    printf("\n%d", argc);
+    if (argc <= 1)
+        scanf("%d", &n);
+
+    return 0;
+}
+//---------------------------------------------------------------------------
+void Delay(unsigned int mseconds)
+{
+    clock_t goal = mseconds + clock();
+    while (goal > clock())
+        ;
+}
+//---------------------------------------------------------------------------
+
+char Load_File(void)
+{
+    FILE *fp;
+    char tc[10];
+    int row_input, column_input, n;
+
+    fp = fopen("of.txt", "r");
+    assert(fp != NULL);
+
+    fscanf(fp, "%d", &n);
+
+    while ((fscanf(fp, "%s", tc)) != EOF)
+    {
+        row_input = tc[0] - 97;
+        column_input = tc[1] - 49;
+        if (!Play_a_Move(row_input, column_input))
+            printf("%c%d is a Wrong move\n", tc[0], column_input + 1);
+
+        Show_Board_and_Set_Legal_Moves();
+    }
+    fclose(fp);
+    return (n % 2 == 1) ? 'B' : 'W';
+}
+//---------------------------------------------------------------------------
+
+void Init()
+{
+    Total_Time = clock();
+
+    Computer_Take = 0;
+    srand((unsigned int)time(NULL));
+    init_kernels();
+    {
+        int sq;
+        for (sq = 0; sq < Board_Size * Board_Size; ++sq)
+            Neighbour_Mask[sq] = neighbours(1ULL << sq);
+    }
+    init_zobrist();
+    Now_Bits[1] = SQ_BIT(3, 3) | SQ_BIT(4, 4); // white, dark
+    Now_Bits[0] = SQ_BIT(3, 4) | SQ_BIT(4, 3); // black, light
+    Bits_To_Board();
+
+    HandNumber = 0;
+    memset(sequence, -1, sizeof(int) * 100);
+    Turn = 0;
+
+    LastX = LastY = -1;
+    Black_Count = White_Count = 0;
+
+    Search_Counter = 0;
+    Winner = 0;
+}
+//---------------------------------------------------------------------------
+
+int Play_a_Move(int x, int y)
+{
+    FILE *fp;
+
+    if (x == -1 && y == -1)
+    {
+        fp = fopen("of.txt", "r+");
+
+        fprintf(fp, "%2d\n", HandNumber + 1);
+        fclose(fp);
+
+        fp = fopen("of.txt", "a");
+        fprintf(fp, "p9\n");
+        fclose(fp);
+
+        sequence[HandNumber] = -1;
+        HandNumber++;
+        Turn = 1 - Turn;
+        return 1;
+    }
+
+    if (!In_Board(x, y))
+        return 0;
+    Find_Legal_Moves(Stones[Turn]);
+    if (Legal_Moves[x][y] == FALSE)
+        return 0;
+
+    {
+        int me = Turn;
+        Bitboard flips = get_flips(SQ(x, y), Now_Bits[me], Now_Bits[1 - me]);
+
+        if (!Put_a_Stone(x, y))
+            return 0;
+
+        Now_Bits[me] |= flips | SQ_BIT(x, y);
+        Now_Bits[1 - me] ^= flips;
+        Bits_To_Board();
+
+        Compute_Grades(TRUE);
+        return 1;
+    }
+}
+//---------------------------------------------------------------------------
+
+int Put_a_Stone(int x, int y)
+{
+    FILE *fp;
+
+    if (Now_Board[x][y] == 0)
+    {
+        sequence[HandNumber] = Turn;
+        if (HandNumber == 0)
+            fp = fopen("of.txt", "w");
+        else
+            fp = fopen("of.txt", "r+");
+        fprintf(fp, "%2d\n", HandNumber + 1);
+        HandNumber++;
+        fclose(fp);
+
+        Now_Board[x][y] = Stones[Turn];
+        fp = fopen("of.txt", "a");
+        fprintf(fp, "%c%d\n", x + 97, y + 1);
+        ;
+        fclose(fp);
+
+        LastX = x;
+        LastY = y;
+
+        Turn = 1 - Turn;
+
+        return TRUE;
+    }
+    return FALSE;
+}
+//---------------------------------------------------------------------------
+
+void Show_Board_and_Set_Legal_Moves(void)
+{
+    int i, j;
+
+    Find_Legal_Moves(Stones[Turn]);
+
+    printf("a b c d e f g h\n");
+    for (i = 0; i < Board_Size; i++)
+    {
+        for (j = 0; j < Board_Size; j++)
+        {
+            if (Now_Board[j][i] > 0)
+            {
+                if (Now_Board[j][i] == 2)
+                    printf("O "); // white
+                else
+                    printf("X "); // black
+            }
+
+            if (Now_Board[j][i] == 0)
+            {
+                if (Legal_Moves[j][i] == 1)
+                    printf("? ");
+                else
+                    printf(". ");
+            }
+        }
+        printf(" %d\n", i + 1);
+    }
+    printf("\n");
+}
+//---------------------------------------------------------------------------
+
+int Find_Legal_Moves(int color)
+{
+    int i, j;
+    int me = (color == Stones[0]) ? 0 : 1;
+    Bitboard moves = get_moves(Now_Bits[me], Now_Bits[1 - me]);
+
+    for (i = 0; i < Board_Size; i++)
+        for (j = 0; j < Board_Size; j++)
+            Legal_Moves[i][j] = (moves & SQ_BIT(i, j)) ? TRUE : FALSE;
+
+    return bit_count(moves);
+}
+//---------------------------------------------------------------------------
+
+int In_Board(int x, int y)
+{
+    if (x >= 0 && x < Board_Size && y >= 0 && y < Board_Size)
+        return TRUE;
+    else
+        return FALSE;
+}
+//---------------------------------------------------------------------------
+
+int Compute_Grades(int flag)
+{
+    Bitboard black = Now_Bits[0], white = Now_Bits[1];
+    Bitboard near_empty = neighbours(~(black | white));
+
+    // Disc counts and positional weights
+    int B = bit_count(black), W = bit_count(white);
+    int BW = weight_sum(black), WW = weight_sum(white);
+
+    // Frontier discs (stones adjacent to at least one empty square)
+    int frontierB = bit_count(black & near_empty);
+    int frontierW = bit_count(white & near_empty);
+
+    // Mobility
+    int mobilityBlack = bit_count(get_moves(black, white));
+    int mobilityWhite = bit_count(get_moves(white, black));
+
+    int totalDiscs = B + W;
+    int stage = 0;
+    if (totalDiscs > 0)
+        stage = (totalDiscs * 100) / (Board_Size * Board_Size); // 0..100
+
+    // Normalized differences
+    int discDiffPerc = 0;
+    int posDiffPerc = 0;
+    int mobDiffPerc = 0;
+    int frontierDiffPerc = 0;
+
+    if (B + W != 0)
+        discDiffPerc = 100 * (B - W) / (B + W);
+
+    if (BW + WW != 0)
+        posDiffPerc = 100 * (BW - WW) / (BW + WW);
+
+    if (mobilityBlack + mobilityWhite != 0)
+        mobDiffPerc = 100 * (mobilityBlack - mobilityWhite) / (mobilityBlack + mobilityWhite);
+
+    if (frontierB + frontierW != 0)
+        frontierDiffPerc = 100 * (frontierW - frontierB) / (frontierB + frontierW); // prefer fewer frontier
+
+    // Game phase dependent weights
+    int wDisc = 10 + stage;     // more important late
+    int wPos = 100 - stage / 2; // slightly less important late
+    int wMob = 100 - stage;     // opening/midgame
+    int wFront = 100 - stage;   // opening/midgame
+
+    int score = 0;
+    score += wPos * posDiffPerc;
+    score += wMob * mobDiffPerc;
+    score += wFront * frontierDiffPerc;
+    score += wDisc * discDiffPerc;
+
+    score /= 10; // keep scale reasonable
+
+    if (flag)
+    {
+        Black_Count = B;
+        White_Count = W;
+        printf("#%d Grade: Black %d, White %d\n", HandNumber, B, W);
+    }
+
+    // Positive score means advantage for Black, negative for White.
+    return score;
+}
+//---------------------------------------------------------------------------
+
+int Check_EndGame(void)
+{
+    FILE *fp;
+
+    Black_Count = bit_count(Now_Bits[0]);
+    White_Count = bit_count(Now_Bits[1]);
+
+    if (Black_Count + White_Count == Board_Size * Board_Size)
+    {
+        fp = fopen("of.txt", "a");
+        Total_Time = clock() - Total_Time;
+
+        if (HandNumber % 2 == 1)
+        {
+            fprintf(fp, "Total used time= %d min. %d sec.\n", Total_Time / 60000, (Total_Time % 60000) / 1000);
+            fprintf(fp, "Black used time= %d min. %d sec.\n", Think_Time / 60000, (Think_Time % 60000) / 1000);
+        }
+        else
+        {
+            fprintf(fp, "Total used time= %d min. %d sec.\n", Total_Time / 60000, (Total_Time % 60000) / 1000);
+            fprintf(fp, "White used time= %d min. %d sec.\n", Think_Time / 60000, (Think_Time % 60000) / 1000);
+        }
+
+        if (Black_Count > White_Count)
+        {
+            printf("Black(F) Win!\n");
+            fprintf(fp, "wB%d\n", Black_Count - White_Count);
+            if (Winner == 0)
+                Winner = 1;
+        }
+        else if (Black_Count < White_Count)
+        {
+            printf("White(S) Win!\n");
+            fprintf(fp, "wW%d\n", White_Count - Black_Count);
+            if (Winner == 0)
+                Winner = 2;
+        }
+        else
+        {
+            printf("Draw\n");
+            fprintf(fp, "wZ%d\n", White_Count - Black_Count);
+            Winner = 0;
+        }
+        fclose(fp);
+
+        Show_Board_and_Set_Legal_Moves();
+        printf("Game is over");
+        return TRUE;
+    }
+
+    return FALSE;
+}
+//---------------------------------------------------------------------------
+
+int negamax(int depth, int alpha, int beta, int myturn)
+{
+    int moveCount;
+    int bestVal = -INF;
+    int originalAlpha = alpha;
+    Bitboard P = Now_Bits[myturn], O = Now_Bits[1 - myturn];
+    Bitboard legal;
+
+    unsigned long long key = Now_Key;
+    TTEntry entry;
+    int hit;
+
+    if (Stop_Search)
+        return 0;
+
+    Search_Counter++;
+    TT_Probes++;
+    hit = tt_probe(key, &entry);
+    if (hit)
+        TT_Hits++;
+
+    // TT lookup
+    if (hit && entry.depth >= depth)
+    {
+        if (entry.flag == TT_FLAG_EXACT)
+            return entry.value;
+        else if (entry.flag == TT_FLAG_LOWER && entry.value > alpha)
+            alpha = entry.value;
+        else if (entry.flag == TT_FLAG_UPPER && entry.value < beta)
+            beta = entry.value;
+
+        if (alpha >= beta)
+            return entry.value;
+    }
+
+    legal = get_moves(P, O);
+    moveCount = bit_count(legal);
+    if (moveCount == 0)
+    {
+        if (depth == 0 || get_moves(O, P) == 0)
+        {
+            int eval = (myturn == 0 ? 1 : -1) * Compute_Grades(FALSE);
+            tt_store(key, depth, eval, TT_FLAG_EXACT, -1, -1);
+            return eval;
+        }
+        // pass move
+        {
+            int val;
+            make_pass();
+            val = -negamax(depth - 1, -beta, -alpha, 1 - myturn);
+            unmake_move(myturn);
+            if (Stop_Search)
+                return 0;
+            if (val <= originalAlpha)
+                tt_store(key, depth, val, TT_FLAG_UPPER, -1, -1);
+            else if (val >= beta)
+                tt_store(key, depth, val, TT_FLAG_LOWER, -1, -1);
+            else
+                tt_store(key, depth, val, TT_FLAG_EXACT, -1, -1);
+            return val;
+        }
+    }
+
+    if (depth == 0)
+    {
+        int eval = (myturn == 0 ? 1 : -1) * Compute_Grades(FALSE);
+        tt_store(key, depth, eval, TT_FLAG_EXACT, -1, -1);
+        return eval;
+    }
+
+    // Generate & order moves
+    {
+        Move moves[Board_Size * Board_Size];
+        int m = 0;
+        Bitboard b = legal;
+        while (b)
+        {
+            int sq = first_bit(b);
+            b &= b - 1;
+            moves[m].x = sq & 7;
+            moves[m].y = sq >> 3;
+            moves[m].score = move_heuristic(moves[m].x, moves[m].y);
+            m++;
+        }
+
+        // TT best move ordering bonus if available
+        if (hit && entry.bestX >= 0 && entry.bestY >= 0)
+        {
+            for (int t = 0; t < m; ++t)
+                if (moves[t].x == entry.bestX && moves[t].y == entry.bestY)
+                    moves[t].score += 1000000;
+        }
+
+        // sort by heuristic descending (insertion sort)
+        for (int a = 1; a < m; ++a)
+        {
+            Move keyMove = moves[a];
+            int b = a - 1;
+            while (b >= 0 && moves[b].score < keyMove.score)
+            {
+                moves[b + 1] = moves[b];
+                b--;
+            }
+            moves[b + 1] = keyMove;
+        }
+
+        {
+            int idxMove;
+            int bestX = -1, bestY = -1;
+
+            for (idxMove = 0; idxMove < m; ++idxMove)
+            {
+                int x = moves[idxMove].x;
+                int y = moves[idxMove].y;
+                int val;
+
+                make_move(SQ(x, y), get_flips(SQ(x, y), P, O), myturn);
+                val = -negamax(depth - 1, -beta, -alpha, 1 - myturn);
+                unmake_move(myturn);
+
+                if (val > bestVal)
+                {
+                    bestVal = val;
+                    bestX = x;
+                    bestY = y;
+                }
+                if (val > alpha)
+                    alpha = val;
+                if (alpha_beta_option && alpha >= beta)
+                    break;
+            }
+
+            if (Stop_Search)
+                return 0;
+
+            if (bestVal <= originalAlpha)
+                tt_store(key, depth, bestVal, TT_FLAG_UPPER, bestX, bestY);
+            else if (bestVal >= beta)
+                tt_store(key, depth, bestVal, TT_FLAG_LOWER, bestX, bestY);
+            else
+                tt_store(key, depth, bestVal, TT_FLAG_EXACT, bestX, bestY);
+        }
+    }
+
+    return bestVal;
+}
+
+int negamax_root(int depth, int myturn, int *outX, int *outY)
+{
+    Bitboard P = Now_Bits[myturn], O = Now_Bits[1 - myturn];
+    Bitboard legal = get_moves(P, O);
+    if (legal == 0)
+    {
+        *outX = *outY = -1;
+        return -INF;
+    }
+
+    Move moves[Board_Size * Board_Size];
+    int m = 0;
+
+    while (legal)
+    {
+        int sq = first_bit(legal);
+        legal &= legal - 1;
+        moves[m].x = sq & 7;
+        moves[m].y = sq >> 3;
+        moves[m].score = move_heuristic(moves[m].x, moves[m].y);
+        m++;
+    }
+
+    // Root: use TT best move for ordering if available
+    {
+        TTEntry entry;
+        if (tt_probe(Now_Key, &entry) && entry.bestX >= 0 && entry.bestY >= 0)
+        {
+            for (int t = 0; t < m; ++t)
+                if (moves[t].x == entry.bestX && moves[t].y == entry.bestY)
+                    moves[t].score += 1000000;
+        }
+    }
+
+    // sort moves by heuristic descending (insertion sort)
+    for (int a = 1; a < m; ++a)
+    {
+        Move keyMove = moves[a];
+        int b = a - 1;
+        while (b >= 0 && moves[b].score < keyMove.score)
+        {
+            moves[b + 1] = moves[b];
+            b--;
+        }
+        moves[b + 1] = keyMove;
+    }
+
+    // Lazy SMP helpers start from a different root move so the threads diverge
+    if (Root_Offset > 0 && m > 1)
+    {
+        Move rotated[Board_Size * Board_Size];
+        for (int t = 0; t < m; ++t)
+            rotated[t] = moves[(t + Root_Offset) % m];
+        memcpy(moves, rotated, sizeof(Move) * m);
+    }
+
+    {
+        int bestVal = -INF;
+        int alpha = -INF;
+        int beta = INF;
+        int idxMove;
+
+        *outX = *outY = -1;
+
+        for (idxMove = 0; idxMove < m; ++idxMove)
+        {
+            int x = moves[idxMove].x;
+            int y = moves[idxMove].y;
+            int val;
+
+            make_move(SQ(x, y), get_flips(SQ(x, y), P, O), myturn);
+            val = -negamax(depth - 1, -beta, -alpha, 1 - myturn);
+            unmake_move(myturn);
+
+            if (val > bestVal)
+            {
+                bestVal = val;
+                *outX = x;
+                *outY = y;
+            }
+            if (val > alpha)
+                alpha = val;
+        }
+
+        return bestVal;
+    }
+}
+
+//---------------------------------------------------------------------------
+// Exact endgame solver
+
+// Link the empty squares, best squares (by board_weight) first, and set Parity
+void init_empty_list(Bitboard empty)
+{
+    SquareList *head = &Empty_List[Board_Size * Board_Size];
+    SquareList *last = head;
+    int order[Board_Size * Board_Size];
+    int n = 0, a, b;
+
+    for (a = 0; a < Board_Size * Board_Size; ++a)
+        if (empty & (1ULL << a))
+            order[n++] = a;
+    for (a = 1; a < n; ++a)
+    {
+        int sq = order[a];
+        for (b = a - 1; b >= 0 && board_weight[order[b] & 7][order[b] >> 3] < board_weight[sq & 7][sq >> 3]; --b)
+            order[b + 1] = order[b];
+        order[b + 1] = sq;
+    }
+
+    Parity = 0;
+    head->sq = -1;
+    head->prev = NULL;
+    for (a = 0; a < n; ++a)
+    {
+        SquareList *node = &Empty_List[a];
+        int x = order[a] & 7, y = order[a] >> 3;
+        node->sq = order[a];
+        node->quadrant = 1 << ((x >= 4 ? 1 : 0) | (y >= 4 ? 2 : 0));
+        node->prev = last;
+        last->next = node;
+        last = node;
+        Empty_Node[node->sq] = node;
+        Parity ^= node->quadrant;
+    }
+    last->next = NULL;
+}
+
+// Solver positions are hashed from the two bitboards (side to move first) so
+// exact scores never share keys with the heuristic search entries
+unsigned long long endgame_hash(Bitboard P, Bitboard O)
+{
+    unsigned long long h = P * 0x9E3779B97F4A7C15ULL ^ (O ^ 0x5851F42D4C957F2DULL) * 0xC2B2AE3D27D4EB4FULL;
+    h ^= h >> 32;
+    h *= 0xD6E8FEB86659FD93ULL;
+    return h ^ (h >> 32);
+}
+
+// Game over: remaining empties go to the winner
+int solve_final(Bitboard P, Bitboard O, int empties)
+{
+    int diff = bit_count(P) - bit_count(O);
+    if (diff > 0)
+        return diff + empties;
+    if (diff < 0)
+        return diff - empties;
+    return 0;
+}
+
+int solve_1(Bitboard P, Bitboard O, int sq)
+{
+    int p = bit_count(P);
+    Bitboard f;
+
+    Search_Counter++;
+    f = get_flips(sq, P, O);
+    if (f)
+        return 2 * (p + bit_count(f) + 1) - 64;
+    f = get_flips(sq, O, P);
+    if (f)
+        return 2 * (p - bit_count(f)) - 64;
+    return (2 * p > 63) ? 2 * p - 62 : 2 * p - 64;
+}
+
+int solve_2(Bitboard P, Bitboard O, int alpha, int beta, int s1, int s2, int passed)
+{
+    int best = -INF, v;
+    Bitboard f;
+
+    Search_Counter++;
+    if ((O & Neighbour_Mask[s1]) && (f = get_flips(s1, P, O)) != 0)
+    {
+        best = -solve_1(O ^ f, P | f | (1ULL << s1), s2);
+        if (best >= beta)
+            return best;
+    }
+    if ((O & Neighbour_Mask[s2]) && (f = get_flips(s2, P, O)) != 0)
+    {
+        v = -solve_1(O ^ f, P | f | (1ULL << s2), s1);
+        if (v > best)
+            best = v;
+    }
+
+    if (best == -INF)
+    {
+        if (passed)
+            return solve_final(P, O, 2);
+        return -solve_2(O, P, -beta, -alpha, s1, s2, TRUE);
+    }
+    return best;
+}
+
+int solve_3(Bitboard P, Bitboard O, int alpha, int beta, int s1, int s2, int s3, int passed)
+{
+    int sqs[3] = {s1, s2, s3};
+    int best = -INF, v, i;
+    Bitboard f;
+
+    Search_Counter++;
+    for (i = 0; i < 3; ++i)
+    {
+        int sq = sqs[i];
+        if (!(O & Neighbour_Mask[sq]) || (f = get_flips(sq, P, O)) == 0)
+            continue;
+        v = -solve_2(O ^ f, P | f | (1ULL << sq), -beta, -(alpha > best ? alpha : best),
+                     sqs[i == 0 ? 1 : 0], sqs[i == 2 ? 1 : 2], FALSE);
+        if (v > best)
+        {
+            best = v;
+            if (best >= beta)
+                return best;
+        }
+    }
+
+    if (best == -INF)
+    {
+        if (passed)
+            return solve_final(P, O, 3);
+        return -solve_3(O, P, -beta, -alpha, s1, s2, s3, TRUE);
+    }
+    return best;
+}
+
+// s1..s4 come in parity order (squares of odd quadrants first)
+int solve_4(Bitboard P, Bitboard O, int alpha, int beta, int s1, int s2, int s3, int s4, int passed)
+{
+    int sqs[4] = {s1, s2, s3, s4};
+    int best = -INF, v, i;
+    Bitboard f;
+
+    Search_Counter++;
+    for (i = 0; i < 4; ++i)
+    {
+        int sq = sqs[i];
+        int r[3], j, k = 0;
+        if (!(O & Neighbour_Mask[sq]) || (f = get_flips(sq, P, O)) == 0)
+            continue;
+        for (j = 0; j < 4; ++j)
+            if (j != i)
+                r[k++] = sqs[j];
+        v = -solve_3(O ^ f, P | f | (1ULL << sq), -beta, -(alpha > best ? alpha : best), r[0], r[1], r[2], FALSE);
+        if (v > best)
+        {
+            best = v;
+            if (best >= beta)
+                return best;
+        }
+    }
+
+    if (best == -INF)
+    {
+        if (passed)
+            return solve_final(P, O, 4);
+        return -solve_4(O, P, -beta, -alpha, s1, s2, s3, s4, TRUE);
+    }
+    return best;
+}
+
+// A few empties: walk the empty list, odd-parity quadrants first
+int solve_shallow(Bitboard P, Bitboard O, int alpha, int beta, int empties, int passed)
+{
+    SquareList *head = &Empty_List[Board_Size * Board_Size];
+    SquareList *node;
+    int best = -INF, v, pass;
+
+    if (empties <= 4)
+    {
+        int sqs[4] = {-1, -1, -1, -1};
+        int n = 0;
+        for (pass = 0; pass < 2; ++pass)
+            for (node = head->next; node; node = node->next)
+                if (((Parity & node->quadrant) != 0) == (pass == 0))
+                    sqs[n++] = node->sq;
+
+        switch (empties)
+        {
+        case 4:
+            return solve_4(P, O, alpha, beta, sqs[0], sqs[1], sqs[2], sqs[3], passed);
+        case 3:
+            return solve_3(P, O, alpha, beta, sqs[0], sqs[1], sqs[2], passed);
+        case 2:
+            return solve_2(P, O, alpha, beta, sqs[0], sqs[1], passed);
+        case 1:
+            return solve_1(P, O, sqs[0]);
+        default:
+            return solve_final(P, O, 0);
+        }
+    }
+
+    Search_Counter++;
+    for (pass = 0; pass < 2; ++pass)
+        for (node = head->next; node; node = node->next)
+        {
+            int sq = node->sq;
+            Bitboard f;
+            if (((Parity & node->quadrant) != 0) != (pass == 0))
+                continue;
+            if (!(O & Neighbour_Mask[sq]) || (f = get_flips(sq, P, O)) == 0)
+                continue;
+
+            node->prev->next = node->next;
+            if (node->next)
+                node->next->prev = node->prev;
+            Parity ^= node->quadrant;
+
+            v = -solve_shallow(O ^ f, P | f | (1ULL << sq), -beta, -alpha, empties - 1, FALSE);
+
+            Parity ^= node->quadrant;
+            node->prev->next = node;
+            if (node->next)
+                node->next->prev = node;
+
+            if (v > best)
+            {
+                best = v;
+                if (v > alpha)
+                    alpha = v;
+                if (alpha >= beta)
+                    return best;
+            }
+        }
+
+    if (best == -INF)
+    {
+        if (passed)
+            return solve_final(P, O, empties);
+        return -solve_shallow(O, P, -beta, -alpha, empties, TRUE);
+    }
+    return best;
+}
+
+// Fastest-first: fewest opponent replies (corners count double) first, odd
+// quadrants before even ones, the TT move before everything
+int order_endgame_moves(Bitboard P, Bitboard O, Bitboard legal, int hashSq, EndMove *moves)
+{
+    const Bitboard corners = 0x8100000000000081ULL;
+    int n = 0, a, b;
+
+    while (legal)
+    {
+        int sq = first_bit(legal);
+        Bitboard f = get_flips(sq, P, O);
+        Bitboard reply = get_moves(O ^ f, P | f | (1ULL << sq));
+        legal &= legal - 1;
+
+        moves[n].sq = sq;
+        moves[n].flips = f;
+        moves[n].score = (bit_count(reply) + bit_count(reply & corners)) * 4;
+        if (Parity & Empty_Node[sq]->quadrant)
+            moves[n].score -= 1;
+        if (sq == hashSq)
+            moves[n].score = -INF;
+        n++;
+    }
+
+    for (a = 1; a < n; ++a)
+    {
+        EndMove keyMove = moves[a];
+        for (b = a - 1; b >= 0 && moves[b].score > keyMove.score; --b)
+            moves[b + 1] = moves[b];
+        moves[b + 1] = keyMove;
+    }
+    return n;
+}
+
+int solve_deep(Bitboard P, Bitboard O, int alpha, int beta, int empties)
+{
+    EndMove moves[Board_Size * Board_Size];
+    Bitboard legal;
+    unsigned long long key = 0;
+    int originalAlpha;
+    int hashSq = -1;
+    int best = -INF, bestSq = -1;
+    int n, i;
+
+    if (empties <= ENDGAME_SHALLOW)
+        return solve_shallow(P, O, alpha, beta, empties, FALSE);
+
+    Search_Counter++;
+
+    if (empties >= ENDGAME_TT_EMPTIES)
+    {
+        TTEntry entry;
+        key = endgame_hash(P, O);
+        if (tt_probe(key, &entry) && entry.depth == empties)
+        {
+            if (entry.flag == TT_FLAG_EXACT)
+                return entry.value;
+            else if (entry.flag == TT_FLAG_LOWER && entry.value > alpha)
+                alpha = entry.value;
+            else if (entry.flag == TT_FLAG_UPPER && entry.value < beta)
+                beta = entry.value;
+            if (alpha >= beta)
+                return entry.value;
+            if (entry.bestX >= 0)
+                hashSq = SQ(entry.bestX, entry.bestY);
+        }
+    }
+
+    originalAlpha = alpha;
+
+    legal = get_moves(P, O);
+    if (legal == 0)
+    {
+        if (get_moves(O, P) == 0)
+            return solve_final(P, O, empties);
+        return -solve_deep(O, P, -beta, -alpha, empties);
+    }
+
+    n = order_endgame_moves(P, O, legal, hashSq, moves);
+    for (i = 0; i < n; ++i)
+    {
+        SquareList *node = Empty_Node[moves[i].sq];
+        Bitboard f = moves[i].flips;
+        int v;
+
+        node->prev->next = node->next;
+        if (node->next)
+            node->next->prev = node->prev;
+        Parity ^= node->quadrant;
+
+        v = -solve_deep(O ^ f, P | f | (1ULL << moves[i].sq), -beta, -alpha, empties - 1);
+
+        Parity ^= node->quadrant;
+        node->prev->next = node;
+        if (node->next)
+            node->next->prev = node;
+
+        if (v > best)
+        {
+            best = v;
+            bestSq = moves[i].sq;
+            if (v > alpha)
+                alpha = v;
+            if (alpha >= beta)
+                break;
+        }
+    }
+
+    if (empties >= ENDGAME_TT_EMPTIES)
+    {
+        int flag = TT_FLAG_EXACT;
+        if (best <= originalAlpha)
+            flag = TT_FLAG_UPPER;
+        else if (best >= beta)
+            flag = TT_FLAG_LOWER;
+        tt_store(key, empties, best, flag, bestSq & 7, bestSq >> 3);
+    }
+    return best;
+}
+
+// Solve the current position exactly; returns the final disc difference for myturn
+int solve_root(int myturn, int *outX, int *outY)
+{
+    Bitboard P = Now_Bits[myturn], O = Now_Bits[1 - myturn];
+    Bitboard legal = get_moves(P, O);
+    int empties = count_empty();
+    EndMove moves[Board_Size * Board_Size];
+    int alpha = -Board_Size * Board_Size - 1, beta = Board_Size * Board_Size + 1;
+    int best = -INF;
+    int n, i;
+
+    *outX = *outY = -1;
+    if (legal == 0)
+        return -INF;
+
+    init_empty_list(~(P | O));
+    n = order_endgame_moves(P, O, legal, -1, moves);
+    for (i = 0; i < n; ++i)
+    {
+        SquareList *node = Empty_Node[moves[i].sq];
+        Bitboard f = moves[i].flips;
+        int v;
+
+        node->prev->next = node->next;
+        if (node->next)
+            node->next->prev = node->prev;
+        Parity ^= node->quadrant;
+
+        v = -solve_deep(O ^ f, P | f | (1ULL << moves[i].sq), -beta, -alpha, empties - 1);
+
+        Parity ^= node->quadrant;
+        node->prev->next = node;
+        if (node->next)
+            node->next->prev = node;
+
+        if (v > best)
+        {
+            best = v;
+            *outX = moves[i].sq & 7;
+            *outY = moves[i].sq >> 3;
+            if (v > alpha)
+                alpha = v;
+        }
+    }
+    return best;
+}
+//---------------------------------------------------------------------------
+
+int Search(int myturn, int mylevel)
+{
+    int legal;
+    int empty;
+    int maxDepth;
+    int d;
+
+    (void)mylevel; // unused
+
+    legal = bit_count(get_moves(Now_Bits[myturn], Now_Bits[1 - myturn]));
+    if (legal <= 0)
+        return FALSE;
+
+    empty = count_empty();
+    maxDepth = search_deep;
+
+    // Extend deeper in late game
+    if (empty <= 14 && empty < maxDepth)
+        maxDepth = empty;
+
+    resultX = resultY = -1;
+
+    // Endgame: solve for the exact final score instead of the heuristic search
+    if (empty <= endgame_empties)
+    {
+        int score = solve_root(myturn, &resultX, &resultY);
+        printf("exact endgame score %+d\n", score);
+        return (resultX != -1 && resultY != -1);
+    }
+
+    // The only full hash of the search; every node below updates it incrementally
+    Now_Key = compute_hash(myturn);
+    Undo_Ply = 0;
+
+    // Lazy SMP: helpers fill the shared TT while this thread searches
+    Stop_Search = FALSE;
+    for (d = 1; d < Search_Threads && d < MAX_THREADS; ++d)
+    {
+        SearchHelper *h = &Helpers[d];
+        h->id = d;
+        h->myturn = myturn;
+        h->maxDepth = maxDepth;
+        h->bits[0] = Now_Bits[0];
+        h->bits[1] = Now_Bits[1];
+        h->nodes = 0;
+        if (pthread_create(&h->thread, NULL, search_helper, h) != 0)
+            h->id = 0;
+    }
+
+    // Iterative deepening for better move ordering and TT usage
+    for (d = 1; d <= maxDepth; ++d)
+    {
+        int x = -1, y = -1;
+        negamax_root(d, myturn, &x, &y);
+        if (x != -1 && y != -1)
+        {
+            resultX = x;
+            resultY = y;
+        }
+    }
+
+    Stop_Search = TRUE;
+    for (d = 1; d < Search_Threads && d < MAX_THREADS; ++d)
+        if (Helpers[d].id != 0)
+        {
+            pthread_join(Helpers[d].thread, NULL);
+            Search_Counter += Helpers[d].nodes;
+        }
+    Stop_Search = FALSE;
+
+    return (resultX != -1 && resultY != -1);
+}
+
+// Lazy SMP helper: odd helpers start one ply deeper, and each rotates its root moves
+void *search_helper(void *arg)
+{
+    SearchHelper *h = (SearchHelper *)arg;
+    int d;
+
+    Now_Bits[0] = h->bits[0];
+    Now_Bits[1] = h->bits[1];
+    Now_Key = compute_hash(h->myturn);
+    Undo_Ply = 0;
+    Search_Counter = 0;
+    Root_Offset = h->id;
+
+    for (d = 1 + (h->id & 1); d <= h->maxDepth && !Stop_Search; ++d)
+    {
+        int x, y;
+        negamax_root(d, h->myturn, &x, &y);
+    }
+
+    h->nodes = Search_Counter;
+    return NULL;
+}
+
+int search_next(int x, int y, int myturn, int mylevel, int alpha, int beta)
+{
+    // Legacy interface not used by new search; keep stub for compatibility.
+    (void)x;
+    (void)y;
+    (void)myturn;
+    (void)mylevel;
+    (void)alpha;
+    (void)beta;
+    return Compute_Grades(FALSE);
+}
+//---------------------------------------------------------------------------
+
+void Computer_Think(int *x, int *y)
+{
+    time_t clockBegin, clockEnd;
+    int flag;
+
+    clockBegin = clock();
+
+    resultX = resultY = -1;
+    Search_Counter = 0;
+
+    flag = Search(Turn, 0);
+
+    clockEnd = clock();
+    {
+        int tinterval = (int)(clockEnd - clockBegin);
+        Think_Time += tinterval;
+        if (tinterval < 200)
+            Delay((unsigned int)(200 - tinterval));
+    }
+    printf("used thinking time= %d min. %d.%d sec.\n",
+           Think_Time / 60000,
+           (Think_Time % 60000) / 1000,
+           (Think_Time % 60000) % 1000);
+
+    if (flag)
+    {
+        *x = resultX;
+        *y = resultY;
+    }
+    else
+    {
+        *x = *y = -1;
+    }
+}
+//---------------------------------------------------------------------------
+
+// Position string: 64 squares a1..h1, a2..h2, ... ('X' black, 'O' white, '-' or '.' empty)
+// followed by the side to move ('X' or 'O').  Sets the board and Turn.
+int Set_Position(const char *pos)
+{
+    Bitboard bits[2] = {0, 0};
+    int sq;
+
+    if (strlen(pos) < Board_Size * Board_Size + 1)
+        return FALSE;
+
+    for (sq = 0; sq < Board_Size * Board_Size; ++sq)
+    {
+        char c = pos[sq];
+        if (c == 'X' || c == 'x' || c == '*')
+            bits[0] |= 1ULL << sq;
+        else if (c == 'O' || c == 'o')
+            bits[1] |= 1ULL << sq;
+        else if (c != '-' && c != '.')
+            return FALSE;
+    }
+
+    switch (pos[Board_Size * Board_Size])
+    {
+    case 'X':
+    case 'x':
+    case '*':
+        Turn = 0;
+        break;
+    case 'O':
+    case 'o':
+        Turn = 1;
+        break;
+    default:
+        return FALSE;
+    }
+
+    Now_Bits[0] = bits[0];
+    Now_Bits[1] = bits[1];
+    Bits_To_Board();
+    return TRUE;
+}
+//---------------------------------------------------------------------------
+
+// Leaf count of the move tree; a pass uses up one ply, a finished game is a leaf
+unsigned long long perft(int depth, int myturn)
+{
+    Bitboard P = Now_Bits[myturn], O = Now_Bits[1 - myturn];
+    Bitboard legal = get_moves(P, O);
+    unsigned long long nodes = 0;
+
+    if (depth == 0)
+        return 1;
+
+    if (legal == 0)
+    {
+        if (get_moves(O, P) == 0)
+            return 1;
+        make_pass();
+        nodes = perft(depth - 1, 1 - myturn);
+        unmake_move(myturn);
+        return nodes;
+    }
+
+    if (depth == 1)
+        return bit_count(legal);
+
+    while (legal)
+    {
+        int sq = first_bit(legal);
+        legal &= legal - 1;
+        make_move(sq, get_flips(sq, P, O), myturn);
+        nodes += perft(depth - 1, 1 - myturn);
+        unmake_move(myturn);
+    }
+    return nodes;
+}
+
+// perft from the current position, with per-root-move counts if divide is set
+void Run_Perft(int depth, int divide)
+{
+    clock_t clockBegin = clock();
+    unsigned long long nodes = 0;
+    int myturn = Turn;
+    double seconds;
+
+    Now_Key = compute_hash(myturn);
+    Undo_Ply = 0;
+
+    if (divide && depth > 0)
+    {
+        Bitboard P = Now_Bits[myturn], O = Now_Bits[1 - myturn];
+        Bitboard legal = get_moves(P, O);
+
+        if (legal == 0)
+        {
+            nodes = perft(depth, myturn);
+            printf("pass: %llu\n", nodes);
+        }
+        while (legal)
+        {
+            int sq = first_bit(legal);
+            unsigned long long n;
+            legal &= legal - 1;
+            make_move(sq, get_flips(sq, P, O), myturn);
+            n = perft(depth - 1, 1 - myturn);
+            unmake_move(myturn);
+            printf("%c%d: %llu\n", (sq & 7) + 97, (sq >> 3) + 1, n);
+            nodes += n;
+        }
+    }
+    else
+        nodes = perft(depth, myturn);
+
+    seconds = (double)(clock() - clockBegin) / CLOCKS_PER_SEC;
+    printf("perft(%d) = %llu nodes, %.3f sec., %.0f nodes/sec\n",
+           depth, nodes, seconds, seconds > 0 ? nodes / seconds : 0.0);
+}
+//---------------------------------------------------------------------------
+
+// Search every bench position from a cleared TT with fixed Zobrist keys, so node
+// counts only change when the search changes.  depth > 0 overrides the table depths.
+void Run_Bench(int depth, int json)
+{
+    int n = sizeof(Bench_Positions) / sizeof(Bench_Positions[0]);
+    unsigned long long totalNodes = 0, totalProbes = 0, totalHits = 0;
+    double totalSeconds = 0;
+    int i;
+
+    if (json)
+        printf("{\"version\": %d, \"positions\": [\n", BENCH_VERSION);
+    else
+        printf("version,id,depth,empty,nodes,ms,nps,tt_hit_pct,best\n");
+
+    for (i = 0; i < n; ++i)
+    {
+        clock_t clockBegin;
+        double seconds;
+        char best[16] = "pass";
+
+        Set_Position(Bench_Positions[i].pos);
+        srand(1);
+        init_zobrist();
+        search_deep = (depth > 0) ? depth : Bench_Positions[i].depth;
+        Search_Counter = 0;
+        TT_Probes = TT_Hits = 0;
+
+        clockBegin = clock();
+        if (Search(Turn, 0))
+            sprintf(best, "%c%d", resultX + 97, resultY + 1);
+        seconds = (double)(clock() - clockBegin) / CLOCKS_PER_SEC;
+
+        totalNodes += Search_Counter;
+        totalProbes += TT_Probes;
+        totalHits += TT_Hits;
+        totalSeconds += seconds;
+
+        if (json)
+            printf("  {\"id\": %d, \"depth\": %d, \"empty\": %d, \"nodes\": %d, \"ms\": %.0f, \"nps\": %.0f, \"tt_hit_pct\": %.1f, \"best\": \"%s\"}%s\n",
+                   i + 1, search_deep, count_empty(), Search_Counter, seconds * 1000,
+                   seconds > 0 ? Search_Counter / seconds : 0.0,
+                   TT_Probes ? 100.0 * TT_Hits / TT_Probes : 0.0, best, (i + 1 < n) ? "," : "");
+        else
+            printf("%d,%d,%d,%d,%d,%.0f,%.0f,%.1f,%s\n",
+                   BENCH_VERSION, i + 1, search_deep, count_empty(), Search_Counter, seconds * 1000,
+                   seconds > 0 ? Search_Counter / seconds : 0.0,
+                   TT_Probes ? 100.0 * TT_Hits / TT_Probes : 0.0, best);
+    }
+
+    if (json)
+        printf("], \"total\": {\"nodes\": %llu, \"ms\": %.0f, \"nps\": %.0f, \"tt_hit_pct\": %.1f}}\n",
+               totalNodes, totalSeconds * 1000, totalSeconds > 0 ? totalNodes / totalSeconds : 0.0,
+               totalProbes ? 100.0 * totalHits / totalProbes : 0.0);
+    else
+        printf("%d,total,,,%llu,%.0f,%.0f,%.1f,\n",
+               BENCH_VERSION, totalNodes, totalSeconds * 1000, totalSeconds > 0 ? totalNodes / totalSeconds : 0.0,
+               totalProbes ? 100.0 * totalHits / totalProbes : 0.0);
+}
+//---------------------------------------------------------------------------